@@ -0,0 +1,339 @@
+#include "bench/BenchHarness.h"
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QSysInfo>
+#include <QTextStream>
+#include <QThread>
+#include <ctime>
+#include <memory>
+#include <vector>
+
+namespace bench {
+
+void useCharPointer(const volatile char *)
+{
+}
+
+static qint64 cpuNowNs()
+{
+    return qint64(double(std::clock()) * 1e9 / CLOCKS_PER_SEC);
+}
+
+State::State(quint64 iterations)
+    : maxIterations(iterations),
+      running(false),
+      realNs(0),
+      cpuStartNs(0),
+      cpuNs(0),
+      itemsProcessed(0)
+{
+}
+
+State::Iterator State::begin()
+{
+    startTimer();
+    return Iterator(this, maxIterations);
+}
+
+State::Iterator State::end()
+{
+    return Iterator(this, 0);
+}
+
+void State::pauseTiming()
+{
+    stopTimer();
+}
+
+void State::resumeTiming()
+{
+    startTimer();
+}
+
+quint64 State::iterations() const
+{
+    return maxIterations;
+}
+
+void State::setItemsProcessed(quint64 items)
+{
+    itemsProcessed = items;
+}
+
+void State::setCounter(const QString &name, double value, bool isRate)
+{
+    counters.append(qMakePair(name, qMakePair(value, isRate)));
+}
+
+void State::startTimer()
+{
+    if (running) {
+        return;
+    }
+    running = true;
+    cpuStartNs = cpuNowNs();
+    realTimer.start();
+}
+
+void State::stopTimer()
+{
+    if (!running) {
+        return;
+    }
+    realNs += realTimer.nsecsElapsed();
+    cpuNs += cpuNowNs() - cpuStartNs;
+    running = false;
+}
+
+void State::finishRunning()
+{
+    stopTimer();
+}
+
+Benchmark::Benchmark(const QString &name, std::function<void(State &)> function)
+    : name(name),
+      function(std::move(function)),
+      fixedIterations(0),
+      timeUnit(TimeUnit::Nanosecond)
+{
+}
+
+Benchmark *Benchmark::iterations(quint64 iterations)
+{
+    fixedIterations = iterations;
+    return this;
+}
+
+Benchmark *Benchmark::unit(TimeUnit unit)
+{
+    timeUnit = unit;
+    return this;
+}
+
+const QString &Benchmark::getName() const
+{
+    return name;
+}
+
+static std::vector<std::unique_ptr<Benchmark>> &registry()
+{
+    static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+    return benchmarks;
+}
+
+Benchmark *registerBenchmark(const QString &name, std::function<void(State &)> function)
+{
+    registry().push_back(std::make_unique<Benchmark>(name, std::move(function)));
+    return registry().back().get();
+}
+
+/**
+ * @brief Runs benchmarks and turns their timings into report entries
+ */
+class Runner
+{
+public:
+    explicit Runner(double minTimeSeconds) : minTimeNs(qint64(minTimeSeconds * 1e9)) {}
+
+    /**
+     * @brief Run a benchmark, calibrating the iteration count unless it is fixed
+     * @param benchmark The benchmark
+     * @return Report entry in Google Benchmark's JSON schema
+     */
+    QJsonObject run(const Benchmark &benchmark)
+    {
+        // Grow the iteration count until a run lasts the minimum time, like
+        // Google Benchmark: aim 40% past it, but never more than 10x at once
+        quint64 iterations = benchmark.fixedIterations ? benchmark.fixedIterations : 1;
+        forever {
+            State state(iterations);
+            benchmark.function(state);
+            state.stopTimer();
+
+            if (benchmark.fixedIterations || state.realNs >= minTimeNs || iterations >= MaxIterations) {
+                return report(benchmark, state);
+            }
+            double multiplier = state.realNs > 0 ? 1.4 * minTimeNs / state.realNs : 10.0;
+            multiplier = qBound(2.0, multiplier, 10.0);
+            iterations = qMin(MaxIterations, quint64(iterations * multiplier));
+        }
+    }
+
+private:
+    static constexpr quint64 MaxIterations = 1000000000ULL;
+
+    qint64 minTimeNs;
+
+    static double unitNs(TimeUnit unit)
+    {
+        switch (unit) {
+            case TimeUnit::Microsecond: return 1e3;
+            case TimeUnit::Millisecond: return 1e6;
+            case TimeUnit::Nanosecond: break;
+        }
+        return 1.0;
+    }
+
+    static QString unitName(TimeUnit unit)
+    {
+        switch (unit) {
+            case TimeUnit::Microsecond: return "us";
+            case TimeUnit::Millisecond: return "ms";
+            case TimeUnit::Nanosecond: break;
+        }
+        return "ns";
+    }
+
+    QJsonObject report(const Benchmark &benchmark, const State &state) const
+    {
+        double iterations = double(state.maxIterations);
+        double seconds = state.realNs / 1e9;
+
+        QJsonObject entry;
+        entry["name"] = benchmark.name;
+        entry["run_name"] = benchmark.name;
+        entry["run_type"] = "iteration";
+        entry["iterations"] = iterations;
+        entry["real_time"] = state.realNs / iterations / unitNs(benchmark.timeUnit);
+        entry["cpu_time"] = state.cpuNs / iterations / unitNs(benchmark.timeUnit);
+        entry["time_unit"] = unitName(benchmark.timeUnit);
+        if (state.itemsProcessed > 0 && seconds > 0) {
+            entry["items_per_second"] = state.itemsProcessed / seconds;
+        }
+        for (const auto &counter : state.counters) {
+            bool isRate = counter.second.second;
+            double value = counter.second.first;
+            entry[counter.first] = isRate ? (seconds > 0 ? value / seconds : 0.0) : value / iterations;
+        }
+        return entry;
+    }
+};
+
+/**
+ * @brief Format a report entry as a console table row
+ * @param entry Report entry
+ * @return Row text
+ */
+static QString consoleRow(const QJsonObject &entry)
+{
+    static const QStringList standardKeys = {"name", "run_name", "run_type", "iterations",
+                                             "real_time", "cpu_time", "time_unit"};
+    QString unit = entry["time_unit"].toString();
+    QString row = QString("%1 %2 %3 %4 %5 %6")
+        .arg(entry["name"].toString(), -40)
+        .arg(QString::number(entry["real_time"].toDouble(), 'f', 1), 12).arg(unit, -2)
+        .arg(QString::number(entry["cpu_time"].toDouble(), 'f', 1), 12).arg(unit, -2)
+        .arg(QString::number(qint64(entry["iterations"].toDouble())), 12);
+    for (auto it = entry.constBegin(); it != entry.constEnd(); ++it) {
+        if (!standardKeys.contains(it.key())) {
+            row += QString(" %1=%2").arg(it.key(), QString::number(it.value().toDouble(), 'g', 4));
+        }
+    }
+    return row;
+}
+
+int runBenchmarks(int argc, char *argv[])
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QString filter = ".";
+    QString format = "console";
+    QString outFile;
+    double minTimeSeconds = 0.5;
+    bool listOnly = false;
+    for (int i = 1; i < argc; ++i) {
+        QString argument = QString::fromLocal8Bit(argv[i]);
+        QString value = argument.section('=', 1);
+        if (argument.startsWith("--benchmark_filter=")) {
+            filter = value;
+        } else if (argument.startsWith("--benchmark_min_time=")) {
+            // Accept Google Benchmark's "0.5s" spelling as well
+            minTimeSeconds = value.endsWith('s') ? value.chopped(1).toDouble() : value.toDouble();
+        } else if (argument.startsWith("--benchmark_format=")) {
+            format = value;
+        } else if (argument.startsWith("--benchmark_out=")) {
+            outFile = value;
+        } else if (argument == "--benchmark_list_tests" || argument == "--benchmark_list_tests=true") {
+            listOnly = true;
+        } else {
+            err << "bench: unknown argument '" << argument << "'" << Qt::endl;
+            return 1;
+        }
+    }
+    if (format != "console" && format != "json") {
+        err << "bench: unknown format '" << format << "'" << Qt::endl;
+        return 1;
+    }
+
+    QRegularExpression filterExpression(filter);
+    if (!filterExpression.isValid()) {
+        err << "bench: invalid filter '" << filter << "'" << Qt::endl;
+        return 1;
+    }
+
+    if (listOnly) {
+        for (const auto &benchmark : registry()) {
+            if (filterExpression.match(benchmark->getName()).hasMatch()) {
+                out << benchmark->getName() << Qt::endl;
+            }
+        }
+        return 0;
+    }
+
+    bool console = format == "console";
+    if (console) {
+        QString header = QString("%1 %2 %3 %4")
+            .arg("Benchmark", -40).arg("Time", 15).arg("CPU", 15).arg("Iterations", 12);
+        out << QString(header.size(), '-') << Qt::endl << header << Qt::endl
+            << QString(header.size(), '-') << Qt::endl;
+    }
+
+    Runner runner(minTimeSeconds);
+    QJsonArray results;
+    for (const auto &benchmark : registry()) {
+        if (!filterExpression.match(benchmark->getName()).hasMatch()) {
+            continue;
+        }
+        QJsonObject entry = runner.run(*benchmark);
+        results.append(entry);
+        if (console) {
+            out << consoleRow(entry) << Qt::endl;
+        }
+    }
+
+    QJsonObject context;
+    context["date"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    context["host_name"] = QSysInfo::machineHostName();
+    context["executable"] = QString::fromLocal8Bit(argv[0]);
+    context["num_cpus"] = QThread::idealThreadCount();
+#ifdef NDEBUG
+    context["library_build_type"] = "release";
+#else
+    context["library_build_type"] = "debug";
+#endif
+
+    QJsonObject document;
+    document["context"] = context;
+    document["benchmarks"] = results;
+    QByteArray json = QJsonDocument(document).toJson(QJsonDocument::Indented);
+
+    if (!console) {
+        out << json;
+    }
+    if (!outFile.isEmpty()) {
+        QFile file(outFile);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            err << "bench: cannot write " << outFile << ": " << file.errorString() << Qt::endl;
+            return 1;
+        }
+        file.write(json);
+    }
+    return 0;
+}
+
+} // namespace bench
@@ -0,0 +1,188 @@
+#ifndef BENCHHARNESS_H
+#define BENCHHARNESS_H
+
+#include <QString>
+#include <QList>
+#include <QPair>
+#include <QElapsedTimer>
+#include <functional>
+
+/**
+ * @brief Minimal micro-benchmark harness in the style of Google Benchmark
+ *
+ * Benchmarks are written the same way (a function looping over its State with
+ * range-for) and accept the same --benchmark_* flags, and the JSON output uses
+ * Google Benchmark's schema, so its tools (e.g. compare.py) can diff two runs.
+ * It exists so the bench target builds without third-party dependencies.
+ */
+namespace bench {
+
+enum class TimeUnit
+{
+    Nanosecond,
+    Microsecond,
+    Millisecond
+};
+
+/**
+ * @brief Escape hatch for values that must not be optimised away
+ *
+ * Defined out of line, so the compiler has to materialise the value.
+ */
+void useCharPointer(const volatile char *);
+
+/**
+ * @brief Keep the compiler from optimising away the computation of a value
+ * @param value Result of the code under test
+ */
+template <class T>
+inline void doNotOptimize(const T &value)
+{
+    useCharPointer(&reinterpret_cast<const volatile char &>(value));
+}
+
+/**
+ * @brief Timing state of one benchmark run, iterated by the benchmark body
+ *
+ * The timer runs from the start of the range-for loop until it ends, except
+ * between pauseTiming() and resumeTiming().
+ */
+class State
+{
+public:
+    // Marked so that "for (auto _ : state)" does not warn about an unused variable
+    struct [[maybe_unused]] Value {};
+
+    class Iterator
+    {
+    public:
+        Iterator(State *state, quint64 remaining) : state(state), remaining(remaining) {}
+        Value operator*() const { return Value(); }
+        Iterator &operator++() { --remaining; return *this; }
+        bool operator!=(const Iterator &) const
+        {
+            if (remaining != 0) {
+                return true;
+            }
+            state->finishRunning();
+            return false;
+        }
+
+    private:
+        State *state;
+        quint64 remaining;
+    };
+
+    explicit State(quint64 iterations);
+
+    Iterator begin();
+    Iterator end();
+
+    /**
+     * @brief Stop the timer, e.g. around per-iteration setup
+     */
+    void pauseTiming();
+
+    /**
+     * @brief Restart the timer after pauseTiming()
+     */
+    void resumeTiming();
+
+    /**
+     * @brief Get the number of iterations of this run
+     * @return Iterations the loop runs for
+     */
+    quint64 iterations() const;
+
+    /**
+     * @brief Report the items processed, shown as items_per_second
+     * @param items Items processed over all iterations
+     */
+    void setItemsProcessed(quint64 items);
+
+    /**
+     * @brief Report a user counter, averaged per iteration unless it is a rate
+     * @param name Counter name, e.g. "nodes"
+     * @param value Counter total over all iterations
+     * @param isRate Divide by the elapsed time instead of the iteration count
+     */
+    void setCounter(const QString &name, double value, bool isRate = false);
+
+private:
+    friend class Runner;
+
+    quint64 maxIterations;
+    bool running;
+    QElapsedTimer realTimer;
+    qint64 realNs;
+    qint64 cpuStartNs;
+    qint64 cpuNs;
+    quint64 itemsProcessed;
+    QList<QPair<QString, QPair<double, bool>>> counters;
+
+    void startTimer();
+    void stopTimer();
+    void finishRunning();
+};
+
+/**
+ * @brief A registered benchmark; setters return this for chaining
+ */
+class Benchmark
+{
+public:
+    Benchmark(const QString &name, std::function<void(State &)> function);
+
+    /**
+     * @brief Run a fixed number of iterations instead of calibrating
+     * @param iterations Iterations per run
+     * @return This benchmark
+     */
+    Benchmark *iterations(quint64 iterations);
+
+    /**
+     * @brief Set the unit times are reported in
+     * @param unit Time unit
+     * @return This benchmark
+     */
+    Benchmark *unit(TimeUnit unit);
+
+    /**
+     * @brief Get the name of the benchmark
+     * @return Name in the output
+     */
+    const QString &getName() const;
+
+private:
+    friend class Runner;
+
+    QString name;
+    std::function<void(State &)> function;
+    quint64 fixedIterations; // 0 to calibrate against the minimum time
+    TimeUnit timeUnit;
+};
+
+/**
+ * @brief Register a benchmark
+ * @param name Name in the output, "BM_<what>/<variant>" by convention
+ * @param function Benchmark body
+ * @return The benchmark, for setting options
+ */
+Benchmark *registerBenchmark(const QString &name, std::function<void(State &)> function);
+
+/**
+ * @brief Run the registered benchmarks selected by the command line
+ *
+ * Understands --benchmark_filter=<regex>, --benchmark_min_time=<seconds>,
+ * --benchmark_format=<console|json>, --benchmark_out=<file> and
+ * --benchmark_list_tests.
+ *
+ * @param argc Argument count
+ * @param argv Arguments
+ * @return Process exit code
+ */
+int runBenchmarks(int argc, char *argv[]);
+
+} // namespace bench
+
+#endif // BENCHHARNESS_H
@@ -0,0 +1,331 @@
+/*
+    * pegbench.cpp
+    * Micro-benchmarks of the model hot paths and full solves from the
+    * standard positions of every board type.
+*/
+
+#include <QRandomGenerator>
+#include <QVector>
+#include "bench/BenchHarness.h"
+#include "models/Board.h"
+#include "models/EndgameGenerator.h"
+#include "models/Solver.h"
+#include "models/TranspositionTable.h"
+#include "core/Board.h"
+
+// Fixed seeds keep the positions identical between runs and machines
+static const quint32 PositionSeed = 20240601;
+static const quint32 TableSeed = 7;
+
+// Positions per board type used by the move and state id benchmarks
+static const int PositionsPerType = 64;
+
+// Pegs in the endgame position used for the endgame solve
+static const int EndgamePegCount = 12;
+
+// Sides of the square layouts benchmarked on the engine directly: one state
+// word (7x7, for reference), two (9x9) and four (15x15)
+static const int SquareSides[] = {7, 9, 15};
+
+static const struct { const char *name; BoardType type; } BoardTypes[] = {
+    {"english", BoardType::English},
+    {"diamond", BoardType::Diamond},
+    {"square", BoardType::Square},
+    {"antipeg", BoardType::AntiPeg},
+    {"endgame", BoardType::Endgame},
+};
+
+/**
+ * @brief Get the starting position of a board type
+ *
+ * The endgame board is set up randomly, so its position comes from backward
+ * play with a fixed seed instead.
+ *
+ * @param boardType The board type
+ * @return Cells of the starting position, row by row
+ */
+static QVector<QVector<PegState>> startingPosition(BoardType boardType)
+{
+    if (boardType == BoardType::Endgame) {
+        QRandomGenerator rng(PositionSeed);
+        QVector<QVector<PegState>> cells;
+        while (!EndgameGenerator::playBackwards(EndgamePegCount, rng, cells)) {
+        }
+        return cells;
+    }
+    return Board(boardType).getCells();
+}
+
+/**
+ * @brief Get a reproducible sample of positions met while playing a board type
+ *
+ * Random games from the starting position, sampled at every depth, so the
+ * sample covers the opening, the middle game and the end.
+ *
+ * @param boardType The board type
+ * @return PositionsPerType positions, row by row
+ */
+static QVector<QVector<QVector<PegState>>> samplePositions(BoardType boardType)
+{
+    QRandomGenerator rng(PositionSeed);
+    QVector<QVector<QVector<PegState>>> positions;
+    Board board;
+    while (positions.size() < PositionsPerType) {
+        board.loadState(boardType, startingPosition(boardType));
+        forever {
+            positions.append(board.getCells());
+            QVector<Move> moves = board.getValidMoves();
+            if (moves.isEmpty() || positions.size() == PositionsPerType) {
+                break;
+            }
+            board.performMove(moves[rng.bounded(int(moves.size()))]);
+        }
+    }
+    return positions;
+}
+
+/**
+ * @brief Load the sample positions of a board type into boards
+ * @param boardType The board type
+ * @return One board per sample position; the caller owns them
+ */
+static QVector<Board *> sampleBoards(BoardType boardType)
+{
+    QVector<Board *> boards;
+    for (const QVector<QVector<PegState>> &cells : samplePositions(boardType)) {
+        Board *board = new Board;
+        board->loadState(boardType, cells);
+        boards.append(board);
+    }
+    return boards;
+}
+
+static void benchGetValidMoves(bench::State &state, BoardType boardType)
+{
+    QVector<Board *> boards = sampleBoards(boardType);
+    quint64 moves = 0;
+    int i = 0;
+    for (auto _ : state) {
+        QVector<Move> valid = boards[i++ % boards.size()]->getValidMoves();
+        moves += valid.size();
+        bench::doNotOptimize(valid);
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setCounter("moves", double(moves));
+    qDeleteAll(boards);
+}
+
+static void benchGenerateMoves(bench::State &state, BoardType boardType)
+{
+    QVector<Board *> boards = sampleBoards(boardType);
+    QVector<Move> buffer(boards.first()->getMaxMoveCount());
+    quint64 moves = 0;
+    int i = 0;
+    for (auto _ : state) {
+        int count = boards[i++ % boards.size()]->generateMoves(buffer.data());
+        moves += count;
+        bench::doNotOptimize(count);
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setCounter("moves", double(moves));
+    qDeleteAll(boards);
+}
+
+static void benchPerformUndo(bench::State &state, BoardType boardType)
+{
+    // One perform and one undo of every legal move of every sample position
+    QVector<Board *> boards = sampleBoards(boardType);
+    QVector<QPair<Board *, Move>> moves;
+    for (Board *board : boards) {
+        for (const Move &move : board->getValidMoves()) {
+            moves.append(qMakePair(board, move));
+        }
+    }
+    int i = 0;
+    for (auto _ : state) {
+        const QPair<Board *, Move> &entry = moves[i++ % moves.size()];
+        entry.first->performMove(entry.second);
+        entry.first->undoLastMove();
+    }
+    state.setItemsProcessed(state.iterations());
+    qDeleteAll(boards);
+}
+
+static void benchGetBoardStateId(bench::State &state, BoardType boardType)
+{
+    QVector<Board *> boards = sampleBoards(boardType);
+    int i = 0;
+    for (auto _ : state) {
+        quint64 stateId = boards[i++ % boards.size()]->getBoardStateId();
+        bench::doNotOptimize(stateId);
+    }
+    state.setItemsProcessed(state.iterations());
+    qDeleteAll(boards);
+}
+
+static void benchSolve(bench::State &state, BoardType boardType)
+{
+    // Solved the way the game does: anti-peg positions through their dual
+    QVector<QVector<PegState>> cells = Board::dualCells(boardType, startingPosition(boardType));
+    BoardType solveType = Board::dualBoardType(boardType);
+    quint64 nodes = 0;
+    for (auto _ : state) {
+        state.pauseTiming();
+        Board board;
+        board.loadState(solveType, cells);
+        TranspositionTable table;
+        Solver solver(&board, table);
+        state.resumeTiming();
+
+        Solver::Result result = solver.solve(nullptr);
+        bench::doNotOptimize(result);
+        nodes += solver.getNodesSearched();
+    }
+    state.setCounter("nodes", double(nodes));
+    state.setCounter("nodes_per_second", double(nodes), true);
+}
+
+/**
+ * @brief Benchmark move generation or state ids on a square layout of any size
+ *
+ * Runs on engine boards of the layout's own state type, from random games
+ * on the full board with the centre hole empty, sampled at every depth.
+ *
+ * @param state Benchmark state
+ * @param side Rows and columns of the layout
+ * @param stateIds Measure canonicalId() instead of generateMoves()
+ */
+static void benchSquareLayout(bench::State &state, int side, bool stateIds)
+{
+    pegcore::Layout layout(std::vector<std::string>(side, std::string(side, 'o')), 3);
+    pegcore::withStateType(layout, [&](auto emptyState) {
+        using State = decltype(emptyState);
+        QRandomGenerator rng(PositionSeed);
+        std::vector<pegcore::Move> buffer(layout.jumps().size());
+        std::vector<pegcore::BasicBoard<State>> boards;
+        while (int(boards.size()) < PositionsPerType) {
+            State pegs = layout.allCells<State>();
+            pegcore::flipBit(pegs, layout.cellAt(side / 2, side / 2));
+            pegcore::BasicBoard<State> board(layout, pegcore::Rules::Normal, pegs);
+            forever {
+                boards.push_back(board);
+                int count = board.generateMoves(buffer.data());
+                if (count == 0 || int(boards.size()) == PositionsPerType) {
+                    break;
+                }
+                board.play(buffer[rng.bounded(count)]);
+            }
+        }
+
+        int i = 0;
+        if (stateIds) {
+            for (auto _ : state) {
+                State stateId = boards[i++ % boards.size()].canonicalId();
+                bench::doNotOptimize(stateId);
+            }
+        } else {
+            for (auto _ : state) {
+                int count = boards[i++ % boards.size()].generateMoves(buffer.data());
+                bench::doNotOptimize(count);
+            }
+        }
+        state.setItemsProcessed(state.iterations());
+    });
+}
+
+/**
+ * @brief Make reproducible state ids that look like canonical ids
+ * @param count Number of ids
+ * @return Random ids
+ */
+static QVector<quint64> randomStateIds(int count)
+{
+    QRandomGenerator rng(TableSeed);
+    QVector<quint64> ids(count);
+    for (quint64 &id : ids) {
+        id = rng.generate64();
+    }
+    return ids;
+}
+
+static void benchTableMark(bench::State &state)
+{
+    static const int IdCount = 1 << 20;
+    QVector<quint64> ids = randomStateIds(IdCount);
+    TranspositionTable table;
+    int i = 0;
+    for (auto _ : state) {
+        if (i == IdCount) {
+            // Start over on an empty table, so every mark inserts a new state
+            state.pauseTiming();
+            table.clear();
+            i = 0;
+            state.resumeTiming();
+        }
+        table.markFailure(ids[i++]);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+static void benchTableLookup(bench::State &state, bool hit)
+{
+    static const int IdCount = 1 << 16;
+    QVector<quint64> ids = randomStateIds(2 * IdCount);
+    TranspositionTable table;
+    for (int i = 0; i < IdCount; ++i) {
+        table.markFailure(ids[i]);
+    }
+    int offset = hit ? 0 : IdCount;
+    int i = 0;
+    for (auto _ : state) {
+        bool known = table.isKnownFailure(ids[offset + (i++ & (IdCount - 1))]);
+        bench::doNotOptimize(known);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+/**
+ * @brief Register every benchmark, once per board type where it applies
+ */
+static void registerBenchmarks()
+{
+    for (const auto &entry : BoardTypes) {
+        BoardType type = entry.type;
+        QString suffix = QString("/%1").arg(entry.name);
+        bench::registerBenchmark("BM_GetValidMoves" + suffix,
+                                 [type](bench::State &state) { benchGetValidMoves(state, type); });
+        bench::registerBenchmark("BM_GenerateMoves" + suffix,
+                                 [type](bench::State &state) { benchGenerateMoves(state, type); });
+        bench::registerBenchmark("BM_PerformUndo" + suffix,
+                                 [type](bench::State &state) { benchPerformUndo(state, type); });
+        bench::registerBenchmark("BM_GetBoardStateId" + suffix,
+                                 [type](bench::State &state) { benchGetBoardStateId(state, type); });
+    }
+
+    for (int side : SquareSides) {
+        QString suffix = QString("/square%1x%1").arg(side);
+        bench::registerBenchmark("BM_EngineGenerateMoves" + suffix,
+                                 [side](bench::State &state) { benchSquareLayout(state, side, false); });
+        bench::registerBenchmark("BM_EngineCanonicalId" + suffix,
+                                 [side](bench::State &state) { benchSquareLayout(state, side, true); });
+    }
+
+    bench::registerBenchmark("BM_TableMark", benchTableMark);
+    bench::registerBenchmark("BM_TableLookup/hit", [](bench::State &state) { benchTableLookup(state, true); });
+    bench::registerBenchmark("BM_TableLookup/miss", [](bench::State &state) { benchTableLookup(state, false); });
+
+    // Full solves take milliseconds to seconds; a few runs are enough
+    for (const auto &entry : BoardTypes) {
+        BoardType type = entry.type;
+        bench::registerBenchmark(QString("BM_Solve/%1").arg(entry.name),
+                                 [type](bench::State &state) { benchSolve(state, type); })
+            ->unit(bench::TimeUnit::Millisecond)
+            ->iterations(type == BoardType::Diamond ? 1 : 5);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    registerBenchmarks();
+    return bench::runBenchmarks(argc, argv);
+}
@@ -0,0 +1,556 @@
+/*
+    * pegsolve.cpp
+    * Headless solver: reads positions from arguments, files or stdin, solves
+    * them and reports the winning line, node counts and timings.
+*/
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QStringList>
+#include <QTextStream>
+#include <QRandomGenerator>
+#include "models/Board.h"
+#include "models/EndgameGenerator.h"
+#include "models/Solver.h"
+#include "models/StopToken.h"
+#include "models/TranspositionTable.h"
+#include "core/Solver.h"
+#include "core/Stats.h"
+#include "core/Trace.h"
+
+// Exit codes
+static const int ExitOk = 0;
+static const int ExitBadInput = 1;  // A position or file could not be read
+static const int ExitTimedOut = 2;  // A search hit the time limit
+
+// Layout tag of custom positions; each is searched with a table of its own
+static const int CustomLayoutTag = 15;
+
+// The endgame board is set up randomly; a bare "endgame" is played backwards
+// from a single peg with this seed instead, so runs are reproducible
+static const quint32 DefaultEndgameSeed = 20240601;
+static const int EndgamePegCount = 12;
+
+/**
+ * @brief A position to solve and where it came from
+ */
+struct PositionSpec
+{
+    QString source; // Argument, "file:line" or "stdin:line"
+    BoardType boardType;
+    bool customLayout; // The cells define their own layout; boardType is unused
+    QVector<QVector<PegState>> cells;
+};
+
+/**
+ * @brief Outcome of solving one position
+ */
+struct SolveReport
+{
+    Solver::Result result;
+    QVector<Move> line; // Winning line in the position's own coordinates
+    int pegCount;
+    quint64 nodesSearched;
+    qint64 elapsedNs;
+};
+
+/**
+ * @brief Map a board type name to its type
+ * @param name Lower-case name, e.g. "english"
+ * @param boardType Receives the type
+ * @return False if the name is unknown
+ */
+static bool parseBoardType(const QString &name, BoardType &boardType)
+{
+    static const struct { const char *name; BoardType type; } types[] = {
+        {"english", BoardType::English},
+        {"diamond", BoardType::Diamond},
+        {"square", BoardType::Square},
+        {"antipeg", BoardType::AntiPeg},
+        {"endgame", BoardType::Endgame},
+    };
+    for (const auto &entry : types) {
+        if (name == QLatin1String(entry.name)) {
+            boardType = entry.type;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Get the name of a board type as used in position specs
+ * @param boardType The board type
+ * @return Lower-case name
+ */
+static QString boardTypeName(BoardType boardType)
+{
+    switch (boardType) {
+        case BoardType::English: return "english";
+        case BoardType::Diamond: return "diamond";
+        case BoardType::Square: return "square";
+        case BoardType::AntiPeg: return "antipeg";
+        case BoardType::Endgame: return "endgame";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Get the name of a position's board type as used in position specs
+ * @param spec The position
+ * @return Lower-case name, "custom" for a custom layout
+ */
+static QString specTypeName(const PositionSpec &spec)
+{
+    return spec.customLayout ? QString("custom") : boardTypeName(spec.boardType);
+}
+
+/**
+ * @brief Parse the cells of a position spec
+ * @param text Rows separated by '/'
+ * @param cells Receives the cells row by row
+ * @param error Receives the reason if a cell is invalid
+ * @return False if a cell is invalid
+ */
+static bool parseCells(const QString &text, QVector<QVector<PegState>> &cells, QString &error)
+{
+    cells.clear();
+    for (const QString &row : text.trimmed().split('/')) {
+        QVector<PegState> rowCells;
+        for (QChar c : row) {
+            if (c == 'o') {
+                rowCells.append(PegState::Peg);
+            } else if (c == '.') {
+                rowCells.append(PegState::Empty);
+            } else if (c == '-') {
+                rowCells.append(PegState::Blocked);
+            } else {
+                error = QString("unexpected cell '%1'").arg(c);
+                return false;
+            }
+        }
+        cells.append(rowCells);
+    }
+    return true;
+}
+
+/**
+ * @brief Parse a position spec
+ *
+ * A spec is a board type name, which stands for that board's starting
+ * position, optionally followed by a colon and the cells row by row. Rows are
+ * separated by '/', with 'o' for a peg, '.' for an empty hole and '-' for a
+ * cell outside the board:
+ *
+ *     english:--ooo--/--ooo--/ooooooo/ooo.ooo/ooooooo/--ooo--/--ooo--
+ *
+ * The cells must have the board type's layout, since state ids and symmetries
+ * are computed for it. The type "custom" takes its layout from the cells
+ * instead, of up to pegcore::Layout::MaxCells cells, and is played under
+ * normal rules.
+ *
+ * The endgame board has no fixed starting position, so a bare "endgame"
+ * stands for a solvable position of EndgamePegCount pegs reached by backward
+ * play with the given seed.
+ *
+ * @param text The spec
+ * @param endgameSeed Seed of the position a bare "endgame" stands for
+ * @param spec Receives the board type and cells
+ * @param error Receives the reason if the spec is invalid
+ * @return False if the spec is invalid
+ */
+static bool parsePosition(const QString &text, quint32 endgameSeed, PositionSpec &spec, QString &error)
+{
+    QString name = text.section(':', 0, 0).trimmed().toLower();
+    spec.customLayout = name == QLatin1String("custom");
+    if (spec.customLayout) {
+        if (!text.contains(':')) {
+            error = "a custom position needs its cells";
+            return false;
+        }
+        if (!parseCells(text.section(':', 1), spec.cells, error)) {
+            return false;
+        }
+        int cellCount = 0;
+        for (const QVector<PegState> &row : spec.cells) {
+            for (PegState state : row) {
+                cellCount += state != PegState::Blocked;
+            }
+        }
+        if (cellCount == 0 || cellCount > pegcore::Layout::MaxCells) {
+            error = QString("a custom layout needs 1 to %1 cells, not %2").arg(pegcore::Layout::MaxCells).arg(cellCount);
+            return false;
+        }
+        return true;
+    }
+
+    if (!parseBoardType(name, spec.boardType)) {
+        error = QString("unknown board type '%1'").arg(name);
+        return false;
+    }
+
+    QVector<QVector<PegState>> layout = Board(spec.boardType).getCells();
+    if (!text.contains(':')) {
+        if (spec.boardType == BoardType::Endgame) {
+            QRandomGenerator rng(endgameSeed);
+            while (!EndgameGenerator::playBackwards(EndgamePegCount, rng, spec.cells)) {
+            }
+            return true;
+        }
+        spec.cells = layout;
+        return true;
+    }
+
+    if (!parseCells(text.section(':', 1), spec.cells, error)) {
+        return false;
+    }
+
+    bool matchesLayout = spec.cells.size() == layout.size();
+    for (int r = 0; matchesLayout && r < layout.size(); ++r) {
+        matchesLayout = spec.cells[r].size() == layout[r].size();
+        for (int c = 0; matchesLayout && c < layout[r].size(); ++c) {
+            matchesLayout = (spec.cells[r][c] == PegState::Blocked) == (layout[r][c] == PegState::Blocked);
+        }
+    }
+    if (!matchesLayout) {
+        error = QString("cells do not match the %1 layout").arg(boardTypeName(spec.boardType));
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Format a move as "(row,col)->(row,col)"
+ * @param move The move
+ * @return Move text
+ */
+static QString formatMove(const Move &move)
+{
+    return QString("(%1,%2)->(%3,%4)")
+        .arg(move.from.row).arg(move.from.col)
+        .arg(move.to.row).arg(move.to.col);
+}
+
+/**
+ * @brief Solve one position
+ *
+ * Anti-peg positions are solved as their normal-mode dual, like in the game,
+ * and the line is mapped back.
+ *
+ * @param spec The position
+ * @param table Table of proven positions to search with
+ * @param timeLimitMsecs Time limit of the search, 0 for none
+ * @return Outcome, line and search statistics
+ */
+static SolveReport solvePosition(const PositionSpec &spec, TranspositionTable &table, qint64 timeLimitMsecs)
+{
+    Board board;
+    board.loadState(Board::dualBoardType(spec.boardType), Board::dualCells(spec.boardType, spec.cells));
+
+    SolveReport report;
+    report.pegCount = Board::dualBoardType(spec.boardType) == spec.boardType
+        ? board.getPegCount()
+        : board.getEmptyCount();
+
+    StopToken stopToken;
+    stopToken.setDeadline(timeLimitMsecs);
+    Solver solver(&board, table);
+
+    QElapsedTimer timer;
+    timer.start();
+    report.result = solver.solve(&stopToken);
+    report.elapsedNs = timer.nsecsElapsed();
+    report.nodesSearched = solver.getNodesSearched();
+
+    for (const Move &move : solver.solutionLine()) {
+        report.line.append(Board::dualMove(spec.boardType, move));
+    }
+    return report;
+}
+
+/**
+ * @brief Solve a position on a custom layout
+ *
+ * Runs the engine directly with the state type of the layout's size, so
+ * layouts of more than 64 cells are searched with the same code as the
+ * standard boards, on wider bit sets.
+ *
+ * @param spec The position; its cells define the layout
+ * @param timeLimitMsecs Time limit of the search, 0 for none
+ * @return Outcome, line and search statistics
+ */
+static SolveReport solveCustomPosition(const PositionSpec &spec, qint64 timeLimitMsecs)
+{
+    std::vector<std::string> diagram;
+    for (const QVector<PegState> &row : spec.cells) {
+        std::string text;
+        for (PegState state : row) {
+            text += state == PegState::Blocked ? '-' : 'o';
+        }
+        diagram.push_back(text);
+    }
+    pegcore::Layout layout(diagram, CustomLayoutTag);
+
+    return pegcore::withStateType(layout, [&](auto emptyState) {
+        using State = decltype(emptyState);
+        State pegs = emptyState;
+        for (int r = 0; r < spec.cells.size(); ++r) {
+            for (int c = 0; c < spec.cells[r].size(); ++c) {
+                if (spec.cells[r][c] == PegState::Peg) {
+                    pegcore::flipBit(pegs, layout.cellAt(r, c));
+                }
+            }
+        }
+        pegcore::BasicBoard<State> board(layout, pegcore::Rules::Normal, pegs);
+        pegcore::BasicTranspositionTable<State> table;
+        pegcore::BasicSolver<State> solver(&board, table);
+
+        SolveReport report;
+        report.pegCount = board.pegCount();
+
+        StopToken stopToken;
+        stopToken.setDeadline(timeLimitMsecs);
+
+        QElapsedTimer timer;
+        timer.start();
+        report.result = solver.solve(&stopToken);
+        report.elapsedNs = timer.nsecsElapsed();
+        report.nodesSearched = solver.getNodesSearched();
+
+        for (const pegcore::Move &move : solver.solutionLine()) {
+            Move gridMove;
+            gridMove.from = Position(layout.rowOf(move.from), layout.colOf(move.from));
+            gridMove.jumped = Position(layout.rowOf(move.over), layout.colOf(move.over));
+            gridMove.to = Position(layout.rowOf(move.to), layout.colOf(move.to));
+            report.line.append(gridMove);
+        }
+        return report;
+    });
+}
+
+/**
+ * @brief Read position specs, one per line, skipping blank lines and '#' comments
+ * @param stream Stream to read from
+ * @param sourceName Name used in the specs' source, e.g. the file name
+ * @param endgameSeed See parsePosition()
+ * @param specs Receives the valid specs
+ * @param err Stream for parse errors
+ * @return False if any line was invalid
+ */
+static bool readPositions(QTextStream &stream, const QString &sourceName, quint32 endgameSeed,
+                          QList<PositionSpec> &specs, QTextStream &err)
+{
+    bool valid = true;
+    int lineNumber = 0;
+    while (!stream.atEnd()) {
+        QString line = stream.readLine().trimmed();
+        lineNumber++;
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        PositionSpec spec;
+        QString error;
+        spec.source = QString("%1:%2").arg(sourceName).arg(lineNumber);
+        if (parsePosition(line, endgameSeed, spec, error)) {
+            specs.append(spec);
+        } else {
+            err << spec.source << ": " << error << Qt::endl;
+            valid = false;
+        }
+    }
+    return valid;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("pegsolve");
+    app.setApplicationVersion("1.0");
+    pegcore::Trace::setThreadName("pegsolve");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Solves peg solitaire positions and reports the winning line, node counts and timings.\n"
+        "A position is a board type (english, diamond, square, antipeg, endgame) for its\n"
+        "starting position, or a type followed by ':' and the rows separated by '/',\n"
+        "with 'o' for a peg, '.' for a hole and '-' for a cell outside the board.\n"
+        "The type 'custom' takes its layout from the rows, up to 250 cells.\n"
+        "A bare 'endgame' is a 12-peg position played backwards with the --seed seed.\n"
+        "Files and stdin hold one position per line; '#' starts a comment line.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("positions", "Positions to solve; '-' reads them from stdin.", "[positions...]");
+    QCommandLineOption fileOption(QStringList() << "f" << "file", "Read positions from <file>.", "file");
+    QCommandLineOption batchOption(QStringList() << "b" << "batch",
+                                   "Print one tab-separated line per position and a summary.");
+    QCommandLineOption timeLimitOption(QStringList() << "t" << "time-limit",
+                                       "Stop each search after <ms> milliseconds.", "ms", "0");
+    QCommandLineOption seedOption("seed",
+                                  "Seed of the position a bare 'endgame' stands for.", "seed",
+                                  QString::number(DefaultEndgameSeed));
+    QCommandLineOption sharedTableOption("shared-table",
+                                         "Keep proven positions between searches instead of starting each one cold.");
+    parser.addOption(fileOption);
+    parser.addOption(batchOption);
+    parser.addOption(timeLimitOption);
+    parser.addOption(seedOption);
+    QCommandLineOption statsOption("stats",
+                                   "Print the search statistics (counters, pruning, branching per ply) at the end.");
+    QCommandLineOption traceOption("trace",
+                                   "Write a Chrome trace of the run to <file>; needs a build with PEG_TRACE.", "file");
+    parser.addOption(sharedTableOption);
+    parser.addOption(statsOption);
+    parser.addOption(traceOption);
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    bool batch = parser.isSet(batchOption);
+    bool inputValid = true;
+
+    bool timeLimitValid = false;
+    qint64 timeLimitMsecs = parser.value(timeLimitOption).toLongLong(&timeLimitValid);
+    if (!timeLimitValid || timeLimitMsecs < 0) {
+        err << "pegsolve: invalid time limit '" << parser.value(timeLimitOption) << "'" << Qt::endl;
+        return ExitBadInput;
+    }
+
+    bool seedValid = false;
+    quint32 endgameSeed = parser.value(seedOption).toUInt(&seedValid);
+    if (!seedValid) {
+        err << "pegsolve: invalid seed '" << parser.value(seedOption) << "'" << Qt::endl;
+        return ExitBadInput;
+    }
+
+    // Gather the positions in the order given
+    QList<PositionSpec> specs;
+    QStringList arguments = parser.positionalArguments();
+    if (arguments.isEmpty() && !parser.isSet(fileOption)) {
+        arguments.append("-");
+    }
+    for (int i = 0; i < arguments.size(); ++i) {
+        if (arguments[i] == "-") {
+            QTextStream in(stdin);
+            inputValid = readPositions(in, "stdin", endgameSeed, specs, err) && inputValid;
+            continue;
+        }
+        PositionSpec spec;
+        QString error;
+        spec.source = QString("arg:%1").arg(i + 1);
+        if (parsePosition(arguments[i], endgameSeed, spec, error)) {
+            specs.append(spec);
+        } else {
+            err << spec.source << ": " << error << Qt::endl;
+            inputValid = false;
+        }
+    }
+    for (const QString &fileName : parser.values(fileOption)) {
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            err << fileName << ": " << file.errorString() << Qt::endl;
+            inputValid = false;
+            continue;
+        }
+        QTextStream in(&file);
+        inputValid = readPositions(in, fileName, endgameSeed, specs, err) && inputValid;
+    }
+
+    if (batch) {
+        out << "# index\tsource\ttype\tpegs\tresult\tmoves\tnodes\tms\tline" << Qt::endl;
+    }
+
+    TranspositionTable table;
+    int solved = 0, unsolvable = 0, interrupted = 0;
+    quint64 totalNodes = 0;
+    qint64 totalNs = 0;
+    for (int i = 0; i < specs.size(); ++i) {
+        const PositionSpec &spec = specs[i];
+        if (!parser.isSet(sharedTableOption)) {
+            table.clear();
+        }
+
+        SolveReport report = spec.customLayout
+            ? solveCustomPosition(spec, timeLimitMsecs)
+            : solvePosition(spec, table, timeLimitMsecs);
+        totalNodes += report.nodesSearched;
+        totalNs += report.elapsedNs;
+
+        QString resultName;
+        switch (report.result) {
+            case Solver::Result::Solved:
+                resultName = "solved";
+                solved++;
+                break;
+            case Solver::Result::Unsolvable:
+                resultName = "unsolvable";
+                unsolvable++;
+                break;
+            case Solver::Result::Interrupted:
+                resultName = "timeout";
+                interrupted++;
+                break;
+        }
+
+        QStringList moves;
+        for (const Move &move : report.line) {
+            moves.append(formatMove(move));
+        }
+        double elapsedMs = report.elapsedNs / 1e6;
+        double nodesPerSecond = report.elapsedNs > 0 ? report.nodesSearched * 1e9 / report.elapsedNs : 0.0;
+
+        if (batch) {
+            out << (i + 1) << '\t' << spec.source << '\t' << specTypeName(spec) << '\t'
+                << report.pegCount << '\t' << resultName << '\t' << report.line.size() << '\t'
+                << report.nodesSearched << '\t' << QString::number(elapsedMs, 'f', 3) << '\t'
+                << moves.join(' ') << Qt::endl;
+        } else {
+            out << "Position " << (i + 1) << " (" << spec.source << ", " << specTypeName(spec)
+                << ", " << report.pegCount << " pegs)" << Qt::endl;
+            out << "  Result: " << resultName;
+            if (report.result == Solver::Result::Solved) {
+                out << " in " << report.line.size() << (report.line.size() == 1 ? " move" : " moves");
+            }
+            out << Qt::endl;
+            if (!moves.isEmpty()) {
+                out << "  Moves:  " << moves.join(' ') << Qt::endl;
+            }
+            out << "  Nodes:  " << report.nodesSearched << " in " << QString::number(elapsedMs, 'f', 3)
+                << " ms (" << QString::number(nodesPerSecond, 'f', 0) << " nodes/s)" << Qt::endl;
+        }
+    }
+
+    if (batch) {
+        out << "# total\t" << specs.size() << " positions\t" << solved << " solved\t" << unsolvable
+            << " unsolvable\t" << interrupted << " timeout\t" << totalNodes << " nodes\t"
+            << QString::number(totalNs / 1e6, 'f', 3) << " ms" << Qt::endl;
+    }
+
+    if (parser.isSet(statsOption)) {
+        // Covers every search of the run; in batch mode as comment lines
+        QString report = QString::fromStdString(pegcore::Stats::snapshot().toText());
+        if (!batch) {
+            out << "Statistics" << Qt::endl;
+        }
+        for (const QString &line : report.split('\n', Qt::SkipEmptyParts)) {
+            out << (batch ? "# " : "  ") << line << Qt::endl;
+        }
+    }
+
+    if (parser.isSet(traceOption)) {
+        if (!pegcore::Trace::Enabled) {
+            err << "pegsolve: built without PEG_TRACE, the trace is empty" << Qt::endl;
+        }
+        QString tracePath = parser.value(traceOption);
+        if (!pegcore::Trace::writeChromeJson(QFile::encodeName(tracePath).toStdString())) {
+            err << "pegsolve: cannot write trace '" << tracePath << "'" << Qt::endl;
+        }
+    }
+
+    if (!inputValid) {
+        return ExitBadInput;
+    }
+    return interrupted > 0 ? ExitTimedOut : ExitOk;
+}
@@ -0,0 +1,41 @@
+# Profile-guided, link-time optimised release build in one go:
+#
+#   cmake -D BUILD_DIR=build-pgo [-D CMAKE_PREFIX_PATH=<Qt>] [-D PEG_NATIVE_ARCH=ON] -P src/cmake/PgoBuild.cmake
+#
+# 1. Configures BUILD_DIR with PEG_PGO=GENERATE and builds an instrumented pegsolve
+# 2. Runs the training workload (target pgo-train): full solves of the
+#    standard English, Diamond and Square positions
+# 3. Reconfigures the same directory with PEG_PGO=USE and rebuilds everything
+#    with the profiles and LTO
+#
+# The same directory is used for both builds because GCC finds each profile
+# by the path of its object file.
+
+cmake_minimum_required(VERSION 3.19)
+
+get_filename_component(SOURCE_DIR "${CMAKE_CURRENT_LIST_DIR}/.." ABSOLUTE)
+if(NOT BUILD_DIR)
+    set(BUILD_DIR build-pgo)
+endif()
+get_filename_component(BUILD_DIR "${BUILD_DIR}" ABSOLUTE)
+set(PROFILE_DIR "${BUILD_DIR}/pgo-profiles")
+
+set(CONFIGURE_ARGS -S "${SOURCE_DIR}" -B "${BUILD_DIR}" -DCMAKE_BUILD_TYPE=Release -DPEG_LTO=ON "-DPEG_PGO_DIR=${PROFILE_DIR}")
+foreach(forwarded CMAKE_PREFIX_PATH CMAKE_CXX_COMPILER PEG_NATIVE_ARCH)
+    if(DEFINED ${forwarded})
+        list(APPEND CONFIGURE_ARGS "-D${forwarded}=${${forwarded}}")
+    endif()
+endforeach()
+
+message(STATUS "PGO 1/3: instrumented build in ${BUILD_DIR}")
+execute_process(COMMAND ${CMAKE_COMMAND} ${CONFIGURE_ARGS} -DPEG_PGO=GENERATE COMMAND_ERROR_IS_FATAL ANY)
+execute_process(COMMAND ${CMAKE_COMMAND} --build "${BUILD_DIR}" --config Release --target pegsolve COMMAND_ERROR_IS_FATAL ANY)
+
+message(STATUS "PGO 2/3: training")
+# Profiles of earlier runs would be merged in and skew the counts
+file(REMOVE_RECURSE "${PROFILE_DIR}")
+execute_process(COMMAND ${CMAKE_COMMAND} --build "${BUILD_DIR}" --config Release --target pgo-train COMMAND_ERROR_IS_FATAL ANY)
+
+message(STATUS "PGO 3/3: optimised build")
+execute_process(COMMAND ${CMAKE_COMMAND} ${CONFIGURE_ARGS} -DPEG_PGO=USE COMMAND_ERROR_IS_FATAL ANY)
+execute_process(COMMAND ${CMAKE_COMMAND} --build "${BUILD_DIR}" --config Release COMMAND_ERROR_IS_FATAL ANY)
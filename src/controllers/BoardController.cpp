@@ -1,9 +1,27 @@
 #include "BoardController.h"
-#include <QDebug>
+#include "core/Trace.h"
+#include "utils/Logging.h"
 #include <QMutexLocker>
 
 // Static member definitions removed - now managed by StrategyWorker
 
+// Longest a hint request may take before a best-effort move is shown
+static const int HintLatencyBudgetMsecs = 100;
+
+// Longest any background computation may run: hint refinement, pondering or a count
+static const int ComputationTimeLimitMsecs = 60000;
+
+// Solution playback speeds in moves per second; the first steps one move per N key press
+static const int PlaybackSpeeds[] = {0, 1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096};
+static const int PlaybackSpeedCount = int(sizeof(PlaybackSpeeds) / sizeof(PlaybackSpeeds[0]));
+static const int DefaultPlaybackSpeedIndex = 3; // 4 moves per second
+
+// Up to this speed pegs glide between cells; above it each frame just shows the moves made
+static const int MaxInterpolatedPlaybackSpeed = 64;
+
+// Playback frame interval, about the display refresh rate
+static const int PlaybackFrameMsecs = 16;
+
 BoardController::BoardController(QObject *parent)
     : QObject(parent),
       boardModel(nullptr),
@@ -13,14 +31,43 @@ BoardController::BoardController(QObject *parent)
       loadingCircle(nullptr),
       strategyWorker(nullptr),
       isComputingStrategy(false),
+      isRefiningStrategy(false),
+      hintJobId(0),
+      hintRequestNs(0),
+      isCountingSolutions(false),
+      countJobId(0),
+      ponderingEnabled(false),
+      endgamePool(nullptr),
+      playSolutionWhenProven(false),
+      playbackIndex(0),
+      playbackSpeedIndex(DefaultPlaybackSpeedIndex),
+      playbackOrigin(0.0),
+      playbackTimer(nullptr),
+      currentInformation("Ready to play"),
       currentKeyboardPosition({-1, -1})
 {
     // Create strategy worker
     strategyWorker = new StrategyWorker(this);
+    strategyWorker->setTimeLimit(ComputationTimeLimitMsecs);
     connect(strategyWorker, &StrategyWorker::strategyComputed,
             this, &BoardController::onStrategyComputed);
+    connect(strategyWorker, &StrategyWorker::progressUpdated,
+            this, &BoardController::onStrategyProgress);
+    connect(strategyWorker, &StrategyWorker::solutionsCounted,
+            this, &BoardController::onSolutionsCounted);
     connect(strategyWorker, &StrategyWorker::computationCancelled,
             this, &BoardController::onStrategyComputationCancelled);
+
+    // Think about the new position in the background as soon as it appears
+    connect(this, &BoardController::boardChanged,
+            this, &BoardController::startPondering);
+
+    // Frame timer of solution playback
+    playbackTimer = new QTimer(this);
+    playbackTimer->setTimerType(Qt::PreciseTimer);
+    playbackTimer->setInterval(PlaybackFrameMsecs);
+    connect(playbackTimer, &QTimer::timeout,
+            this, &BoardController::advancePlayback);
 }
 
 void BoardController::setBoardModel(Board *model)
@@ -34,6 +81,7 @@ void BoardController::setBoardModel(Board *model)
         
         // Check initial game status
         checkGameStatus();
+        startPondering();
     }
 }
 
@@ -59,12 +107,52 @@ Board* BoardController::getBoardModel() const
     return boardModel;
 }
 
+void BoardController::setPonderingEnabled(bool enabled)
+{
+    ponderingEnabled = enabled;
+
+    if (ponderingEnabled) {
+        startPondering();
+    } else if (!isComputingStrategy && !isRefiningStrategy && !isCountingSolutions && strategyWorker) {
+        // Stop a background search nobody is waiting for
+        strategyWorker->requestCancellation();
+    }
+}
+
+void BoardController::setEndgamePool(EndgamePool *pool)
+{
+    endgamePool = pool;
+}
+
+QString BoardController::information() const
+{
+    if (pendingInformation) {
+        currentInformation = pendingInformation();
+        pendingInformation = nullptr;
+    }
+    return currentInformation;
+}
+
+void BoardController::setInformation(const QString &message)
+{
+    pendingInformation = nullptr;
+    currentInformation = message;
+    emit informationChanged();
+}
+
+void BoardController::setInformation(std::function<QString()> build)
+{
+    pendingInformation = std::move(build);
+    emit informationChanged();
+}
+
 void BoardController::onPegCellClicked(const Position &pos)
 {
     if (!boardModel) {
-        qDebug() << "BoardController: No board model set";
+        qCDebug(lcController) << "BoardController: No board model set";
         return;
     }
+    stopPlayback();
     
     PegState clickedState = boardModel->getPegState(pos);
     
@@ -76,12 +164,13 @@ void BoardController::onPegCellClicked(const Position &pos)
               // Get valid moves from this position
             currentValidMoves = getMovesFromPosition(pos);
               if (!currentValidMoves.isEmpty()) {
-                qDebug() << "BoardController: Selected peg at (" << pos.row << "," << pos.col << ") with" << currentValidMoves.size() << "possible moves";
-                emit informationUpdated(QString("Selected peg at (%1,%2)\n%3 possible moves").arg(pos.row).arg(pos.col).arg(currentValidMoves.size()));
+                qCDebug(lcController) << "BoardController: Selected peg at (" << pos.row << "," << pos.col << ") with" << currentValidMoves.size() << "possible moves";
+                int moveCount = currentValidMoves.size();
+                setInformation([pos, moveCount] { return QString("Selected peg at (%1,%2)\n%3 possible moves").arg(pos.row).arg(pos.col).arg(moveCount); });
                 emit highlightMovesSignal(currentValidMoves);
             } else {
-                qDebug() << "BoardController: Selected peg at (" << pos.row << "," << pos.col << ") with no valid moves";
-                emit informationUpdated(QString("Selected peg at (%1,%2)\nNo valid moves available").arg(pos.row).arg(pos.col));
+                qCDebug(lcController) << "BoardController: Selected peg at (" << pos.row << "," << pos.col << ") with no valid moves";
+                setInformation([pos] { return QString("Selected peg at (%1,%2)\nNo valid moves available").arg(pos.row).arg(pos.col); });
                 // Still highlight the selected peg even if it has no valid moves
                 QList<Move> selectedPegHighlight;
                 // Create a dummy move just to highlight the selected peg
@@ -111,31 +200,36 @@ void BoardController::onPegCellClicked(const Position &pos)
                     break;
                 }
             }            if (moveFound && boardModel->performMove(attemptedMove)) {
-                // Cancel any ongoing strategy computation since board state changed
-                if (isComputingStrategy && strategyWorker) {
-                    strategyWorker->requestCancellation();
+                // Keep any ongoing strategy computation alive: the new position is a
+                // child of the one being searched, so the worker re-roots onto it and
+                // a later hint request can be answered from the work already done
+                if ((isComputingStrategy || isRefiningStrategy) && strategyWorker) {
+                    strategyWorker->updatePosition(boardModel->getBoardType(), getBoardData());
                     if (loadingCircle) {
                         loadingCircle->stopAnimation();
                     }
                     isComputingStrategy = false;
+                    isRefiningStrategy = false;
+                    hintJobId = 0;
                 }
+                abandonSolutionCount();
                 
-                qDebug() << "BoardController: Move performed from (" << attemptedMove.from.row << "," << attemptedMove.from.col 
+                qCDebug(lcController) << "BoardController: Move performed from (" << attemptedMove.from.row << "," << attemptedMove.from.col 
                          << ") to (" << attemptedMove.to.row << "," << attemptedMove.to.col 
                          << ") jumping (" << attemptedMove.jumped.row << "," << attemptedMove.jumped.col << ")";
-                emit informationUpdated(QString("Move executed!\nFrom (%1,%2) to (%3,%4)\nJumped over (%5,%6)")
-                                      .arg(attemptedMove.from.row).arg(attemptedMove.from.col)
-                                      .arg(attemptedMove.to.row).arg(attemptedMove.to.col)
-                                      .arg(attemptedMove.jumped.row).arg(attemptedMove.jumped.col));
+                setInformation([attemptedMove] { return QString("Move executed!\nFrom (%1,%2) to (%3,%4)\nJumped over (%5,%6)")
+                                          .arg(attemptedMove.from.row).arg(attemptedMove.from.col)
+                                          .arg(attemptedMove.to.row).arg(attemptedMove.to.col)
+                                          .arg(attemptedMove.jumped.row).arg(attemptedMove.jumped.col); });
                 
                 clearSelection();
-                updateView();
+                updateMoveCells(attemptedMove);
                 emit pegsRemainingChanged(boardModel->getPegCount());
                 emit boardChanged();
                 checkGameStatus();
             } else {
-                qDebug() << "BoardController: Invalid move attempted";
-                emit informationUpdated("Invalid move attempted!\nTry selecting a valid destination.");
+                qCDebug(lcController) << "BoardController: Invalid move attempted";
+                setInformation("Invalid move attempted!\nTry selecting a valid destination.");
             }
         } else {
             // Clicking on same peg - deselect
@@ -151,27 +245,32 @@ void BoardController::onUndoClicked()
     if (!boardModel) {
         return;
     }
+    stopPlayback();
     
+    Move undoneMove = boardModel->getLastMove();
     if (boardModel->undoLastMove()) {
         // Cancel any ongoing strategy computation since board state changed
-        if (isComputingStrategy && strategyWorker) {
+        if ((isComputingStrategy || isRefiningStrategy) && strategyWorker) {
             strategyWorker->requestCancellation();
             if (loadingCircle) {
                 loadingCircle->stopAnimation();
             }
             isComputingStrategy = false;
+            isRefiningStrategy = false;
+            hintJobId = 0;
         }
+        abandonSolutionCount();
         
-        qDebug() << "BoardController: Move undone successfully";
-        emit informationUpdated("Move undone successfully!\nReturned to previous state.");
+        qCDebug(lcController) << "BoardController: Move undone successfully";
+        setInformation("Move undone successfully!\nReturned to previous state.");
         clearSelection();
-        updateView();
+        updateMoveCells(undoneMove);
         emit pegsRemainingChanged(boardModel->getPegCount());
         emit boardChanged();
         checkGameStatus();
     } else {
-        qDebug() << "BoardController: No moves to undo";
-        emit informationUpdated("No moves to undo!\nNo previous moves available.");
+        qCDebug(lcController) << "BoardController: No moves to undo";
+        setInformation("No moves to undo!\nNo previous moves available.");
     }
 }
 
@@ -180,22 +279,30 @@ void BoardController::onResetClicked()
     if (!boardModel) {
         return;
     }
+    stopPlayback();
     
     // Cancel any ongoing strategy computation
-    if (isComputingStrategy && strategyWorker) {
+    if ((isComputingStrategy || isRefiningStrategy) && strategyWorker) {
         strategyWorker->requestCancellation();
         if (loadingCircle) {
             loadingCircle->stopAnimation();
         }
         isComputingStrategy = false;
+        isRefiningStrategy = false;
+        hintJobId = 0;
     }
+    abandonSolutionCount();
     
-    qDebug() << "BoardController: Resetting board";
-    emit informationUpdated("Board reset!\nGame restarted with fresh board.");
+    qCDebug(lcController) << "BoardController: Resetting board";
+    setInformation("Board reset!\nGame restarted with fresh board.");
     
-    // Re-initialize the board with its current type
+    // Re-initialize the board with its current type; endgames get a fresh position
     BoardType currentType = boardModel->getBoardType();
-    boardModel->initializeBoard(currentType);
+    if (currentType == BoardType::Endgame && endgamePool) {
+        boardModel->loadState(currentType, endgamePool->take());
+    } else {
+        boardModel->initializeBoard(currentType);
+    }
     
     clearSelection();
     updateView();
@@ -206,7 +313,8 @@ void BoardController::onResetClicked()
 
 void BoardController::onHomeClicked()
 {
-    qDebug() << "BoardController: Navigating to home";
+    stopPlayback();
+    qCDebug(lcController) << "BoardController: Navigating to home";
     emit navigateToHome();
 }
 
@@ -215,45 +323,76 @@ void BoardController::onSuggestMoveClicked()
     if (!boardModel) {
         return;
     }
+    if (!playbackLine.isEmpty()) {
+        stopPlayback();
+    }
     
     // If already computing strategy, ignore the request
     if (isComputingStrategy) {
-        qDebug() << "BoardController: Strategy computation already in progress";
-        emit informationUpdated("Strategy computation in progress...\nPlease wait for current calculation to complete.");
+        qCDebug(lcController) << "BoardController: Strategy computation already in progress";
+        setInformation("Strategy computation in progress...\nPlease wait for current calculation to complete.");
         return;
     }
     
-    // Start the asynchronous strategy computation
+    // Start the asynchronous strategy computation; it supersedes a running count
     isComputingStrategy = true;
+    isRefiningStrategy = false;
+    isCountingSolutions = false;
+    countJobId = 0;
     
     // Set up the loading circle if not already created
     if (!loadingCircle) {
         loadingCircle = new LoadingCircle(boardView);
     }
     
-    // Copy current board state to pass to worker thread
-    QVector<QVector<PegState>> boardData;
-    boardData.resize(boardModel->getRows());
-    for (int r = 0; r < boardModel->getRows(); ++r) {
-        boardData[r].resize(boardModel->getCols());
-        for (int c = 0; c < boardModel->getCols(); ++c) {
-            Position pos(r, c);
-            boardData[r][c] = boardModel->getPegState(pos);
-        }
-    }
-    
     // Show loading circle with appropriate message
     if (loadingCircle && boardView) {
-        loadingCircle->setMessage("Searching for winning move, this may take a while...");
+        loadingCircle->setMessage("Searching for winning move...");
         loadingCircle->resize(boardView->size());
         loadingCircle->startAnimation();
     }
     
-    // Start the strategy worker thread
-    strategyWorker->computeStrategy(boardModel->getBoardType(), boardData);
+    // Start the strategy worker thread; if no move is proven within the budget
+    // a best-effort move is shown and verified in the background
+    hintRequestNs = pegcore::Trace::nowNs();
+    hintJobId = strategyWorker->computeStrategy(boardModel->getBoardType(), getBoardData(),
+                                                HintLatencyBudgetMsecs, true);
     
-    emit informationUpdated("Analyzing board...\nSearching for optimal strategy...");
-    qDebug() << "BoardController: Started asynchronous strategy computation";
+    setInformation("Analyzing board...\nSearching for optimal strategy...");
+    qCDebug(lcController) << "BoardController: Started asynchronous strategy computation";
+}
+
+void BoardController::onCountSolutionsClicked()
+{
+    if (!boardModel) {
+        return;
+    }
+    stopPlayback();
+
+    if (isComputingStrategy || isCountingSolutions) {
+        qCDebug(lcController) << "BoardController: Computation already in progress, not counting";
+        setInformation("Computation in progress...\nPlease wait for current calculation to complete.");
+        return;
+    }
+
+    // The count supersedes any background refinement of the last hint
+    isRefiningStrategy = false;
+    hintJobId = 0;
+    isCountingSolutions = true;
+
+    if (!loadingCircle) {
+        loadingCircle = new LoadingCircle(boardView);
+    }
+    if (loadingCircle && boardView) {
+        loadingCircle->setMessage("Counting winning lines...");
+        loadingCircle->resize(boardView->size());
+        loadingCircle->startAnimation();
+    }
+
+    countJobId = strategyWorker->countSolutions(boardModel->getBoardType(), getBoardData());
+
+    setInformation("Counting winning lines...\nEvery distinct winning move sequence\nfrom this position is counted.");
+    qCDebug(lcController) << "BoardController: Started counting winning lines";
 }
 
 void BoardController::updateView()
@@ -263,6 +402,22 @@ void BoardController::updateView()
     }
 }
 
+void BoardController::updateMoveCells(const Move &move)
+{
+    if (boardView) {
+        boardView->updateCells({move.from, move.jumped, move.to});
+    }
+}
+
+QVector<QVector<PegState>> BoardController::getBoardData() const
+{
+    // Copy current board state to pass to worker thread
+    if (!boardModel) {
+        return QVector<QVector<PegState>>();
+    }
+    return boardModel->getCells();
+}
+
 void BoardController::clearSelection()
 {
     selectedPosition = {-1, -1};
@@ -300,24 +455,24 @@ void BoardController::checkGameStatus()
     // Check for winning condition first
     if (boardModel->isWinningState()) {
         if (boardModel->isAntiPegMode()) {
-            qDebug() << "BoardController: Anti-peg victory! One empty space remains at starting position.";
-            emit informationUpdated("Victory!\nAnti-peg game won!\nOnly the starting position is empty!");
+            qCDebug(lcController) << "BoardController: Anti-peg victory! One empty space remains at starting position.";
+            setInformation("Victory!\nAnti-peg game won!\nOnly the starting position is empty!");
         } else {
-            qDebug() << "BoardController: Victory! One peg remains at starting position.";
-            emit informationUpdated("Victory!\nPerfect game!\nOne peg remains at the starting position!");
+            qCDebug(lcController) << "BoardController: Victory! One peg remains at starting position.";
+            setInformation("Victory!\nPerfect game!\nOne peg remains at the starting position!");
         }
         emit gameOver();
         return;
     }
     
     int pegCount = boardModel->getPegCount();
-    bool hasValidMoves = !boardModel->getValidMoves().isEmpty();
+    bool hasValidMoves = !boardModel->isGameOver();
     
     if (boardModel->isAntiPegMode()) {
         // Anti-peg mode: game ends when no more moves are available
         if (!hasValidMoves) {
-            qDebug() << "BoardController: Anti-peg game over! Final peg count:" << pegCount;
-            emit informationUpdated(QString("Anti-peg game complete!\nFinal peg count: %1\nNo more moves possible.").arg(pegCount));
+            qCDebug(lcController) << "BoardController: Anti-peg game over! Final peg count:" << pegCount;
+            setInformation([pegCount] { return QString("Anti-peg game complete!\nFinal peg count: %1\nNo more moves possible.").arg(pegCount); });
             emit gameOver();
             return;
         }
@@ -325,163 +480,14 @@ void BoardController::checkGameStatus()
     else {
         // Check for lose condition: no valid moves available (and more than 1 peg)
         if (!hasValidMoves && pegCount > 1) {
-            qDebug() << "BoardController: Game over! No valid moves available. Final peg count:" << pegCount;
-            emit informationUpdated(QString("Game Over!\nNo valid moves available\n%1 pegs remaining").arg(pegCount));
+            qCDebug(lcController) << "BoardController: Game over! No valid moves available. Final peg count:" << pegCount;
+            setInformation([pegCount] { return QString("Game Over!\nNo valid moves available\n%1 pegs remaining").arg(pegCount); });
             emit gameOver();
             return;
         }
     }
 }
 
-Move BoardController::getSuggestedMove()
-{
-    if (!boardModel) {
-        return {Position{-1, -1}, Position{-1, -1}, Position{-1, -1}};
-    }
-    
-    // Only return strategic moves that guarantee a win
-    Move strategicMove = getStrategicMove();
-    return strategicMove; // This will be invalid if no winning solution exists
-}
-
-Move BoardController::getStrategicMove()
-{
-    if (!boardModel) {
-        return {Position{-1, -1}, Position{-1, -1}, Position{-1, -1}};
-    }
-
-    // Check if board is solvable first
-    if (!isBoardSolvable()) {
-        qDebug() << "BoardController: Dead game detected - no winning solution exists";
-        emit deadGameDetected();
-        return {Position{-1, -1}, Position{-1, -1}, Position{-1, -1}};
-    }
-
-    // Find the best strategic move
-    return findBestStrategicMove();
-}
-
-bool BoardController::isBoardSolvable()
-{
-    if (!boardModel) {
-        return false;
-    }
-
-    // Create a copy of the board to test solvability
-    Board* testBoard = new Board(boardModel->getBoardType(), this);
-    
-    // Copy current state
-    for (int r = 0; r < boardModel->getRows(); ++r) {
-        for (int c = 0; c < boardModel->getCols(); ++c) {
-            Position pos(r, c);
-            testBoard->setPegState(pos, boardModel->getPegState(pos));
-        }
-    }
-
-    bool solvable = solveBoard(testBoard);
-    
-    testBoard->deleteLater();
-    return solvable;
-}
-
-bool BoardController::solveBoard(Board* board)
-{
-    if (!board) {
-        return false;
-    }
-
-    // Check win condition - if only 1 peg left and it's at the center
-    if (board->isWinningState()) {
-        return true;
-    }
-
-    // Get unique board state identifier
-    quint64 boardStateId = board->getBoardStateId();
-      // Check if this board state (or any symmetric equivalent) has been flagged as unsolvable
-    {
-        QMutexLocker locker(&StrategyWorker::failedStatesMutex);
-        if (StrategyWorker::failedBoardStates.contains(boardStateId)) {
-            return false; // This board state or a symmetric equivalent leads to no solution
-        }
-    }
-
-    // Get all possible moves
-    QVector<Move> moves = board->getValidMoves();
-    if (moves.isEmpty()) {
-        // No moves available and not in winning state - flag this state as failed
-        QMutexLocker locker(&StrategyWorker::failedStatesMutex);
-        StrategyWorker::failedBoardStates.insert(boardStateId);
-        return false;
-    }
-
-    // Try each move recursively
-    for (const Move& move : moves) {
-        // Make the move
-        if (board->performMove(move)) {
-            // Recursively check if this leads to a solution
-            if (solveBoard(board)) {
-                // Found a solution! Undo the move before returning
-                board->undoLastMove();
-                return true;
-            }
-            // Undo the move and try next
-            board->undoLastMove();
-        }
-    }    // No solution found from this state - flag it as failed
-    {
-        QMutexLocker locker(&StrategyWorker::failedStatesMutex);
-        StrategyWorker::failedBoardStates.insert(boardStateId);
-    }
-    
-    return false;
-}
-
-Move BoardController::findBestStrategicMove()
-{
-    if (!boardModel) {
-        return {Position{-1, -1}, Position{-1, -1}, Position{-1, -1}};
-    }
-
-    QVector<Move> allMoves = boardModel->getValidMoves();
-    if (allMoves.isEmpty()) {
-        return {Position{-1, -1}, Position{-1, -1}, Position{-1, -1}};
-    }
-
-    // Test each move to see which ones lead to winning solutions
-    QVector<Move> winningMoves;
-    
-    for (const Move& move : allMoves) {
-        // Create a test board
-        Board* testBoard = new Board(boardModel->getBoardType(), this);
-        
-        // Copy current state
-        for (int r = 0; r < boardModel->getRows(); ++r) {
-            for (int c = 0; c < boardModel->getCols(); ++c) {
-                Position pos(r, c);
-                testBoard->setPegState(pos, boardModel->getPegState(pos));
-            }
-        }
-
-        // Try this move
-        if (testBoard->performMove(move)) {
-            // Check if this state is still solvable
-            if (solveBoard(testBoard)) {
-                winningMoves.append(move);
-            }
-        }
-          testBoard->deleteLater();
-    }
-    
-    // Return the first winning move found, or invalid move if none guarantee win
-    if (!winningMoves.isEmpty()) {
-        qDebug() << "BoardController: Found" << winningMoves.size() << "winning moves";
-        return winningMoves.first();
-    }
-
-    qDebug() << "BoardController: No guaranteed winning moves found";
-    return {Position{-1, -1}, Position{-1, -1}, Position{-1, -1}};
-}
-
 void BoardController::onPegSelectionRequested(int direction)
 {
     if (!boardModel) {
@@ -492,21 +498,23 @@ void BoardController::onPegSelectionRequested(int direction)
       if (targetPeg.row != -1 && targetPeg.col != -1) {
         // Select the found peg
         onPegCellClicked(targetPeg);
-        qDebug() << "BoardController: Keyboard selected peg at (" << targetPeg.row << "," << targetPeg.col << ")";
-        QString directionName[] = {"Up", "Left", "Down", "Right"};
-        emit informationUpdated(QString("Keyboard navigation:\nSelected peg at (%1,%2)\nDirection: %3")
-                              .arg(targetPeg.row).arg(targetPeg.col).arg(directionName[direction]));
+        qCDebug(lcController) << "BoardController: Keyboard selected peg at (" << targetPeg.row << "," << targetPeg.col << ")";
+        static const char *const directionName[] = {"Up", "Left", "Down", "Right"};
+        setInformation([targetPeg, direction] { return QString("Keyboard navigation:\nSelected peg at (%1,%2)\nDirection: %3")
+                                  .arg(targetPeg.row).arg(targetPeg.col).arg(directionName[direction]); });
     } else {
-        qDebug() << "BoardController: No peg found in direction" << direction;
-        QString directionName[] = {"Up", "Left", "Down", "Right"};
-        emit informationUpdated(QString("Keyboard navigation:\nNo peg found in %1 direction\nTry a different direction").arg(directionName[direction]));
+        qCDebug(lcController) << "BoardController: No peg found in direction" << direction;
+        static const char *const directionName[] = {"Up", "Left", "Down", "Right"};
+        setInformation([direction] { return QString("Keyboard navigation:\nNo peg found in %1 direction\nTry a different direction").arg(directionName[direction]); });
     }
 }
 
 void BoardController::onMoveRequested(int direction)
-{    if (!boardModel || !hasPegSelected) {
-        qDebug() << "BoardController: No peg selected for arrow key move";
-        emit informationUpdated("Arrow key move failed!\nPlease select a peg first\nusing WASD keys.");
+{
+    stopPlayback();
+    if (!boardModel || !hasPegSelected) {
+        qCDebug(lcController) << "BoardController: No peg selected for arrow key move";
+        setInformation("Arrow key move failed!\nPlease select a peg first\nusing WASD keys.");
         return;
     }
 
@@ -525,18 +533,18 @@ void BoardController::onMoveRequested(int direction)
     for (const Move &move : currentValidMoves) {
         if (move.to.row == targetPos.row && move.to.col == targetPos.col) {            // Valid move found, execute it
             onPegCellClicked(targetPos);
-            qDebug() << "BoardController: Executed arrow key move to (" << targetPos.row << "," << targetPos.col << ")";
-            QString directionName[] = {"Up", "Left", "Down", "Right"};
-            emit informationUpdated(QString("Arrow key move executed!\nDirection: %1\nMoved to (%2,%3)")
-                                  .arg(directionName[direction]).arg(targetPos.row).arg(targetPos.col));
+            qCDebug(lcController) << "BoardController: Executed arrow key move to (" << targetPos.row << "," << targetPos.col << ")";
+            static const char *const directionName[] = {"Up", "Left", "Down", "Right"};
+            setInformation([targetPos, direction] { return QString("Arrow key move executed!\nDirection: %1\nMoved to (%2,%3)")
+                                      .arg(directionName[direction]).arg(targetPos.row).arg(targetPos.col); });
             return;
         }
     }
     
-    qDebug() << "BoardController: Invalid arrow key move attempted to (" << targetPos.row << "," << targetPos.col << ")";
-    QString directionName[] = {"Up", "Left", "Down", "Right"};
-    emit informationUpdated(QString("Invalid arrow key move!\nDirection: %1\nNo valid move to (%2,%3)")
-                          .arg(directionName[direction]).arg(targetPos.row).arg(targetPos.col));
+    qCDebug(lcController) << "BoardController: Invalid arrow key move attempted to (" << targetPos.row << "," << targetPos.col << ")";
+    static const char *const directionName[] = {"Up", "Left", "Down", "Right"};
+    setInformation([targetPos, direction] { return QString("Invalid arrow key move!\nDirection: %1\nNo valid move to (%2,%3)")
+                              .arg(directionName[direction]).arg(targetPos.row).arg(targetPos.col); });
 }
 
 Position BoardController::findNearestPeg(int direction)
@@ -699,27 +707,70 @@ Position BoardController::findNearestPegInDirection(int direction)
     return bestPeg;
 }
 
-void BoardController::onStrategyComputed(const Move &move, bool isDeadGame)
+void BoardController::onStrategyComputed(quint64 jobId, const StrategyResult &result)
 {
-    qDebug() << "BoardController: Strategy computation completed";
+    if (jobId != hintJobId || (!isComputingStrategy && !isRefiningStrategy)) {
+        // Result of a request the board has moved on from; the search results
+        // are kept in the transposition table for the next hint request
+        qCDebug(lcController) << "BoardController: Discarding stale strategy result of job" << jobId;
+        return;
+    }
+
+    qCDebug(lcController) << "BoardController: Strategy computation completed";
     
     // Stop the loading animation
     if (loadingCircle) {
         loadingCircle->stopAnimation();
     }
     
+    // A result still being refined is followed by a final one or a cancellation
+    const Move &move = result.move;
+    bool isRefinement = isRefiningStrategy;
     isComputingStrategy = false;
+    isRefiningStrategy = result.isRefining;
+
+    // Whole round trip from the key press, across the worker thread
+    pegcore::Trace::recordAsync("hint", isRefinement ? "hint verified" : "hint", jobId,
+                                hintRequestNs, pegcore::Trace::nowNs());
     
-    if (isDeadGame) {
-        qDebug() << "BoardController: Dead game detected by strategy worker";
-        emit informationUpdated("💀 Dead game detected!\nNo winning moves available.\nThe current board state cannot be won.");
+    if (result.isDeadGame && move.from.row == -1) {
+        qCDebug(lcController) << "BoardController: Dead game detected by strategy worker";
+        setInformation("💀 Dead game detected!\nNo winning moves available.\nThe current board state cannot be won.");
         emit deadGameDetected();
     } else if (move.from.row != -1) {
-        qDebug() << "BoardController: Suggesting winning move from (" << move.from.row << "," << move.from.col 
+        qCDebug(lcController) << "BoardController: Suggesting"
+                 << (result.isDeadGame ? "fewest-pieces" : (result.isProven ? "winning" : "best-effort"))
+                 << "move from (" << move.from.row << "," << move.from.col
                  << ") to (" << move.to.row << "," << move.to.col << ")";
-        emit informationUpdated(QString("✨ Winning move found!\nFrom (%1,%2) to (%3,%4)\nThis move guarantees victory!")
-                              .arg(move.from.row).arg(move.from.col)
-                              .arg(move.to.row).arg(move.to.col));
+        if (result.isDeadGame) {
+            const char *pieces = boardModel && boardModel->isAntiPegMode() ? "empty holes" : "pegs";
+            bool isProven = result.isProven;
+            bool isRefining = result.isRefining;
+            int remainingPegs = result.remainingPegs;
+            setInformation([move, pieces, isProven, isRefining, remainingPegs] {
+                return QString("💀 No perfect finish exists.\n%1 %2 %3 left.\nBest move: from (%4,%5) to (%6,%7)%8")
+                       .arg(isProven ? "Fewest possible:" : "Fewest found so far:")
+                       .arg(remainingPegs).arg(pieces)
+                       .arg(move.from.row).arg(move.from.col)
+                       .arg(move.to.row).arg(move.to.col)
+                       .arg(isProven ? "" : (isRefining ? "\nStill checking in the background..."
+                                                        : "\nNot proven optimal within the time limit."));
+            });
+            emit deadGameDetected();
+        } else if (result.isProven) {
+            setInformation([move, isRefinement] { return QString("%1\nFrom (%2,%3) to (%4,%5)\nThis move guarantees victory!")
+                                      .arg(isRefinement ? "✨ Winning move verified!" : "✨ Winning move found!")
+                                      .arg(move.from.row).arg(move.from.col)
+                                      .arg(move.to.row).arg(move.to.col); });
+        } else if (result.isRefining) {
+            setInformation([move] { return QString("💡 Best move found so far\nFrom (%1,%2) to (%3,%4)\nNot proven yet - still checking in the background...")
+                                      .arg(move.from.row).arg(move.from.col)
+                                      .arg(move.to.row).arg(move.to.col); });
+        } else {
+            setInformation([move] { return QString("💡 Best move found so far\nFrom (%1,%2) to (%3,%4)\nCould not be proven within the time limit.")
+                                      .arg(move.from.row).arg(move.from.col)
+                                      .arg(move.to.row).arg(move.to.col); });
+        }
         
         // Clear current selection and highlight suggested move
         clearSelection();
@@ -730,14 +781,101 @@ void BoardController::onStrategyComputed(const Move &move, bool isDeadGame)
         
         emit highlightMovesSignal(currentValidMoves);
     } else {
-        qDebug() << "BoardController: No winning moves found by strategy worker";
-        emit informationUpdated("🤔 No guaranteed winning moves found!\nThe current position is too complex\nor may not have a perfect solution.");
+        qCDebug(lcController) << "BoardController: No winning moves found by strategy worker";
+        setInformation("🤔 No guaranteed winning moves found!\nThe current position is too complex\nor may not have a perfect solution.");
+    }
+
+    // A best-effort move is followed by the final result; a pending play
+    // request is settled by that one, whether or not it brings a line
+    if (playSolutionWhenProven && !result.isRefining) {
+        playSolutionWhenProven = false;
+        if (result.isProven && !result.line.isEmpty()) {
+            startPlayback(result.line);
+        } else if (result.isDeadGame && move.from.row == -1) {
+            setInformation("💀 Dead game detected!\nNo moves are left to play.");
+        } else if (move.from.row != -1) {
+            setInformation([move] { return QString("⏹ No line to play: none could be\nproven within the time limit.\nBest move so far: from (%1,%2) to (%3,%4)")
+                                      .arg(move.from.row).arg(move.from.col)
+                                      .arg(move.to.row).arg(move.to.col); });
+        } else {
+            setInformation("⏹ No line to play: no winning\nmove was found from here.");
+        }
+    }
+}
+
+void BoardController::onStrategyProgress(quint64 jobId, const SolverProgress &progress)
+{
+    if (!loadingCircle) {
+        return;
+    }
+    if (jobId == countJobId && isCountingSolutions) {
+        loadingCircle->setDetails(QString("%1 positions searched (%2k/s)\n"
+                                          "Root moves counted %3/%4\n"
+                                          "Memo: %5 positions, %6% hit rate")
+                                  .arg(progress.nodesSearched)
+                                  .arg(progress.nodesPerSecond / 1000.0, 0, 'f', 0)
+                                  .arg(progress.rootMovesResolved).arg(progress.rootMovesTotal)
+                                  .arg(progress.tableSize)
+                                  .arg(progress.tableHitRate * 100.0, 0, 'f', 1));
+        return;
+    }
+    if (jobId != hintJobId || !isComputingStrategy) {
+        return;
+    }
+
+    loadingCircle->setDetails(QString("%1 positions searched (%2k/s)\n"
+                                      "Depth %3, root moves resolved %4/%5\n"
+                                      "Cache: %6 positions, %7% hit rate")
+                              .arg(progress.nodesSearched)
+                              .arg(progress.nodesPerSecond / 1000.0, 0, 'f', 0)
+                              .arg(progress.depth)
+                              .arg(progress.rootMovesResolved).arg(progress.rootMovesTotal)
+                              .arg(progress.tableSize)
+                              .arg(progress.tableHitRate * 100.0, 0, 'f', 1));
+}
+
+void BoardController::onSolutionsCounted(quint64 jobId, const SolutionCount &count, bool complete)
+{
+    if (jobId != countJobId || !isCountingSolutions) {
+        qCDebug(lcController) << "BoardController: Discarding stale solution count of job" << jobId;
+        return;
+    }
+
+    if (loadingCircle) {
+        loadingCircle->stopAnimation();
+    }
+    isCountingSolutions = false;
+    countJobId = 0;
+
+    if (!complete) {
+        setInformation("🔢 Counting stopped at the time limit.\nThis position has too many lines\nto count in time.");
+    } else if (count.isZero()) {
+        setInformation("🔢 No winning line exists\nfrom this position.");
+    } else {
+        setInformation([count] { return QString("🔢 %1 winning %2\nfrom this position.")
+                                  .arg(count.toString())
+                                  .arg(count.high == 0 && count.low == 1 ? "line" : "lines"); });
     }
 }
 
-void BoardController::onStrategyComputationCancelled()
+void BoardController::onStrategyComputationCancelled(quint64 jobId)
 {
-    qDebug() << "BoardController: Strategy computation was cancelled";
+    if (jobId != 0 && jobId == countJobId) {
+        qCDebug(lcController) << "BoardController: Solution count was cancelled";
+        if (loadingCircle) {
+            loadingCircle->stopAnimation();
+        }
+        isCountingSolutions = false;
+        countJobId = 0;
+        setInformation("Solution count cancelled.\nYou can try again by pressing C.");
+        return;
+    }
+    if (jobId != hintJobId) {
+        // The request was already abandoned by an undo or reset
+        return;
+    }
+
+    qCDebug(lcController) << "BoardController: Strategy computation was cancelled";
     
     // Stop the loading animation
     if (loadingCircle) {
@@ -745,8 +883,11 @@ void BoardController::onStrategyComputationCancelled()
     }
     
     isComputingStrategy = false;
+    isRefiningStrategy = false;
+    hintJobId = 0;
+    playSolutionWhenProven = false;
     
-    emit informationUpdated("Strategy computation cancelled.\nYou can try again by pressing space.");
+    setInformation("Strategy computation cancelled.\nYou can try again by pressing space.");
 }
 
 void BoardController::onBoardViewResized()
@@ -754,14 +895,208 @@ void BoardController::onBoardViewResized()
     // Resize the loading circle to match the new board view size
     if (loadingCircle && boardView) {
         loadingCircle->resize(boardView->size());
-        qDebug() << "BoardController: Loading circle resized to match board view size:" << boardView->size();
+        qCDebug(lcController) << "BoardController: Loading circle resized to match board view size:" << boardView->size();
+    }
+}
+
+void BoardController::startPondering()
+{
+    if (!ponderingEnabled || !boardModel || !strategyWorker || isComputingStrategy || isRefiningStrategy ||
+        isCountingSolutions) {
+        return;
     }
+
+    qCDebug(lcController) << "BoardController: Pondering current position in the background";
+    strategyWorker->ponder(boardModel->getBoardType(), getBoardData());
+}
+
+void BoardController::abandonSolutionCount()
+{
+    if (!isCountingSolutions || !strategyWorker) {
+        return;
+    }
+
+    // The count was for a position the board has left
+    strategyWorker->requestCancellation();
+    if (loadingCircle) {
+        loadingCircle->stopAnimation();
+    }
+    isCountingSolutions = false;
+    countJobId = 0;
+}
+
+void BoardController::onPlaySolutionRequested()
+{
+    if (!boardModel) {
+        return;
+    }
+
+    if (!playbackLine.isEmpty()) {
+        qCDebug(lcController) << "BoardController: Solution playback stopped at move" << playbackIndex;
+        stopPlayback();
+        setInformation("Solution playback stopped.\nPress P to play the rest.");
+        return;
+    }
+    if (isCountingSolutions) {
+        setInformation("Computation in progress...\nPlease wait for current calculation to complete.");
+        return;
+    }
+
+    // Play the line as soon as a hint for this position is proven; a hint
+    // already being searched or verified is waited for
+    playSolutionWhenProven = true;
+    if (!isComputingStrategy && !isRefiningStrategy) {
+        onSuggestMoveClicked();
+    }
+    qCDebug(lcController) << "BoardController: Solution playback requested";
+}
+
+void BoardController::onPlaybackSpeedChangeRequested(int steps)
+{
+    // Keep the part of the current move already shown
+    double position = playbackIndex;
+    if (!playbackLine.isEmpty() && playbackSpeed() > 0) {
+        position = qMax(position, playbackOrigin + playbackClock.nsecsElapsed() / 1e9 * playbackSpeed());
+    }
+
+    playbackSpeedIndex = qBound(0, playbackSpeedIndex + steps, PlaybackSpeedCount - 1);
+    int speed = playbackSpeed();
+    playbackOrigin = speed > 0 ? position : playbackIndex;
+    playbackClock.restart();
+
+    if (speed > 0) {
+        setInformation([speed] { return QString("Playback speed: %1 %2 per second.")
+                                     .arg(speed).arg(speed == 1 ? "move" : "moves"); });
+    } else {
+        setInformation("Playback speed: single step.\nPress N to play the next move.");
+    }
+    if (playbackLine.isEmpty()) {
+        return;
+    }
+    if (speed > 0) {
+        playbackTimer->start();
+    } else {
+        playbackTimer->stop();
+        if (boardView) {
+            boardView->clearAnimatedMove();
+        }
+    }
+}
+
+void BoardController::onPlaybackStepRequested()
+{
+    if (playbackLine.isEmpty()) {
+        return;
+    }
+
+    if (boardView) {
+        boardView->clearAnimatedMove();
+    }
+    playMovesUpTo(playbackIndex + 1);
+    playbackOrigin = playbackIndex;
+    playbackClock.restart();
+    advancePlayback();
+}
+
+void BoardController::startPlayback(const QVector<Move> &line)
+{
+    playSolutionWhenProven = false;
+    clearSelection();
+
+    playbackLine = line;
+    playbackIndex = 0;
+    playbackOrigin = 0.0;
+    playbackClock.start();
+    if (playbackSpeed() > 0) {
+        playbackTimer->start();
+    }
+
+    qCDebug(lcController) << "BoardController: Playing a line of" << line.size() << "moves";
+    int moveCount = line.size();
+    setInformation([moveCount] { return QString("▶ Playing the solution: %1 moves.\n"
+                                                "+ and - change the speed,\nN steps, P stops.").arg(moveCount); });
+}
+
+void BoardController::stopPlayback()
+{
+    playSolutionWhenProven = false;
+    if (playbackLine.isEmpty()) {
+        return;
+    }
+
+    playbackTimer->stop();
+    if (boardView) {
+        boardView->clearAnimatedMove();
+    }
+    bool movesPlayed = playbackIndex > 0;
+    playbackLine.clear();
+    playbackIndex = 0;
+
+    // Pondering and the other board listeners were held back while playing
+    if (movesPlayed) {
+        emit boardChanged();
+    }
+}
+
+void BoardController::playMovesUpTo(int target)
+{
+    target = qMin(target, int(playbackLine.size()));
+    if (playbackIndex >= target) {
+        return;
+    }
+
+    while (playbackIndex < target) {
+        const Move &move = playbackLine[playbackIndex];
+        if (!boardModel->performMove(move)) {
+            // The line does not fit the board any more; keep what was played
+            qCWarning(lcController) << "BoardController: Solution move" << playbackIndex << "is not legal, stopping playback";
+            playbackIndex = int(playbackLine.size());
+            break;
+        }
+        updateMoveCells(move);
+        playbackIndex++;
+    }
+    emit pegsRemainingChanged(boardModel->getPegCount());
+}
+
+void BoardController::advancePlayback()
+{
+    PEGCORE_TRACE_SCOPE("playback", "frame");
+    if (playbackLine.isEmpty() || !boardModel) {
+        playbackTimer->stop();
+        return;
+    }
+
+    int speed = playbackSpeed();
+    double position = speed > 0 ? playbackOrigin + playbackClock.nsecsElapsed() / 1e9 * speed : playbackIndex;
+    playMovesUpTo(int(position));
+
+    if (playbackIndex >= playbackLine.size()) {
+        qCDebug(lcController) << "BoardController: Solution playback finished";
+        stopPlayback();
+        setInformation("Solution played!");
+        checkGameStatus();
+        return;
+    }
+
+    if (!boardView) {
+        return;
+    }
+    if (speed > 0 && speed <= MaxInterpolatedPlaybackSpeed) {
+        boardView->setAnimatedMove(playbackLine[playbackIndex], position - playbackIndex);
+    } else {
+        boardView->clearAnimatedMove();
+    }
+}
+
+int BoardController::playbackSpeed() const
+{
+    return PlaybackSpeeds[playbackSpeedIndex];
 }
 
 void BoardController::clearFailedStatesCache()
 {
-    // Clear the StrategyWorker's failed states cache
-    QMutexLocker locker(&StrategyWorker::failedStatesMutex);
-    StrategyWorker::failedBoardStates.clear();
-    qDebug() << "BoardController: Failed board states cache cleared";
+    // Clear the StrategyWorker's transposition table
+    StrategyWorker::transpositionTable.clear();
+    qCDebug(lcController) << "BoardController: Failed board states cache cleared";
 }
\ No newline at end of file
@@ -5,10 +5,14 @@
 #include <QList>
 #include <QSet>     // Added for symmetry optimization
 #include <QMutex>   // Added for thread safety
+#include <QTimer>
+#include <QElapsedTimer>
+#include <functional>
 #include "models/Board.h"
 #include "views/BoardView.h"
 #include "views/LoadingCircle.h"
 #include "controllers/StrategyWorker.h"
+#include "controllers/EndgamePool.h"
 
 /**
  * @brief Controller for managing the Peg Solitaire game board interactions
@@ -39,6 +43,28 @@ public:
      */
     Board* getBoardModel() const;
 
+    /**
+     * @brief Enable or disable background pondering of hints
+     * @param enabled True to solve the position in the background after every change
+     */
+    void setPonderingEnabled(bool enabled);
+
+    /**
+     * @brief Set the pool endgame positions are taken from on reset
+     * @param pool Pool of generated endgames, or null to set the board up again
+     */
+    void setEndgamePool(EndgamePool *pool);
+
+    /**
+     * @brief Get the current information message
+     *
+     * Messages are only formatted here, when a view asks to show them, so
+     * messages replaced before they are shown never cost any formatting.
+     *
+     * @return Information message to display
+     */
+    QString information() const;
+
 signals:
     /**
      * @brief Emitted when the board state changes
@@ -70,10 +96,9 @@ signals:
     void deadGameDetected();
     
     /**
-     * @brief Emitted when information about current operation needs to be displayed
-     * @param message Information message to display
+     * @brief Emitted when the information message changes; read it with information()
      */
-    void informationUpdated(const QString &message);
+    void informationChanged();
 
 public slots:
     /**
@@ -100,6 +125,11 @@ public slots:
      */
     void onSuggestMoveClicked();
 
+    /**
+     * @brief Handle a request to count the winning lines (C key)
+     */
+    void onCountSolutionsClicked();
+
     /**
      * @brief Handle WASD peg selection requests
      * @param direction Direction to search for peg (0=up/W, 1=left/A, 2=down/S, 3=right/D)
@@ -112,23 +142,68 @@ public slots:
      */
     void onMoveRequested(int direction);
 
+    /**
+     * @brief Play the winning line from the current position, or stop playing it (P key)
+     *
+     * Asks the strategy worker for a proven line first if none is known.
+     */
+    void onPlaySolutionRequested();
+
+    /**
+     * @brief Change the solution playback speed (+ and - keys)
+     * @param steps Number of speed steps to go up, negative to go down
+     */
+    void onPlaybackSpeedChangeRequested(int steps);
+
+    /**
+     * @brief Play the next move of the solution being played (N key)
+     */
+    void onPlaybackStepRequested();
+
 private slots:
     /**
      * @brief Handle completion of strategy computation
-     * @param move The computed move
-     * @param isDeadGame Whether the game is unwinnable
+     * @param jobId Id of the worker job the result belongs to
+     * @param result The computed move and what is known about it
      */
-    void onStrategyComputed(const Move &move, bool isDeadGame);
-      /**
+    void onStrategyComputed(quint64 jobId, const StrategyResult &result);
+
+    /**
+     * @brief Show the progress of a running strategy computation
+     * @param jobId Id of the worker job the progress belongs to
+     * @param progress Search statistics reported by the worker
+     */
+    void onStrategyProgress(quint64 jobId, const SolverProgress &progress);
+
+    /**
+     * @brief Show the result of a solution count
+     * @param jobId Id of the worker job the count belongs to
+     * @param count Number of winning lines from the position
+     * @param complete False if the count stopped before it finished
+     */
+    void onSolutionsCounted(quint64 jobId, const SolutionCount &count, bool complete);
+
+    /**
      * @brief Handle cancellation of strategy computation
+     * @param jobId Id of the worker job that was cancelled
      */
-    void onStrategyComputationCancelled();
+    void onStrategyComputationCancelled(quint64 jobId);
     
     /**
      * @brief Handle board view resize events
      */
     void onBoardViewResized();
 
+    /**
+     * @brief Start pondering the current position if pondering is enabled
+     */
+    void startPondering();
+
+    /**
+     * @brief Advance solution playback to the current time; runs once per frame
+     */
+    void advancePlayback();
+
 private:
     Board *boardModel;
     BoardView *boardView;
@@ -143,16 +218,91 @@ private:
     // Strategy worker thread
     StrategyWorker *strategyWorker;
     bool isComputingStrategy;
+    bool isRefiningStrategy; // A best-effort hint is shown and still being verified
+    quint64 hintJobId;       // Worker job of the current hint request, 0 for none
+    qint64 hintRequestNs;    // When the current hint was requested, on the trace clock
+    bool isCountingSolutions;
+    quint64 countJobId;      // Worker job of the current solution count, 0 for none
+    bool ponderingEnabled;
+
+    EndgamePool *endgamePool; // Not owned
+
+    // Solution playback
+    bool playSolutionWhenProven; // Play the line of the pending hint once it is proven
+    QVector<Move> playbackLine;  // Line being played, empty when not playing
+    int playbackIndex;           // Moves of the line already played on the board
+    int playbackSpeedIndex;      // Index into the playback speeds; 0 is single-step
+    double playbackOrigin;       // Line position when playbackClock was last restarted
+    QTimer *playbackTimer;
+    QElapsedTimer playbackClock;
+
+    // Builder of the information message not formatted yet, and the last formatted one
+    mutable std::function<QString()> pendingInformation;
+    mutable QString currentInformation;
+
+    /**
+     * @brief Replace the information message
+     * @param message Message to display
+     */
+    void setInformation(const QString &message);
+
+    /**
+     * @brief Replace the information message with one formatted on demand
+     * @param build Returns the message; only called if the message is shown
+     */
+    void setInformation(std::function<QString()> build);
 
     /**
      * @brief Update the view to reflect current board state
      */
     void updateView();
+
+    /**
+     * @brief Repaint only the cells a move touched
+     * @param move Move that was played or taken back
+     */
+    void updateMoveCells(const Move &move);
     
+    /**
+     * @brief Copy the current board state for the strategy worker
+     * @return Cell states, row by row
+     */
+    QVector<QVector<PegState>> getBoardData() const;
+
     /**
      * @brief Clear current selection and highlights
      */
     void clearSelection();
+
+    /**
+     * @brief Drop a running solution count because the board changed
+     */
+    void abandonSolutionCount();
+
+    /**
+     * @brief Start playing a line from the current position
+     * @param line Moves to play, in order
+     */
+    void startPlayback(const QVector<Move> &line);
+
+    /**
+     * @brief Stop solution playback, keeping the moves played so far on the board
+     *
+     * Also drops a pending request to play the line of the next proven hint.
+     */
+    void stopPlayback();
+
+    /**
+     * @brief Play the moves of the line up to a position
+     * @param target Number of moves of the line that should have been played
+     */
+    void playMovesUpTo(int target);
+
+    /**
+     * @brief Get the current playback speed
+     * @return Moves per second, 0 in single-step mode
+     */
+    int playbackSpeed() const;
     
     /**
      * @brief Get valid moves from the selected position
@@ -164,17 +314,7 @@ private:
     /**
      * @brief Check if the game is complete
      */
-    void checkGameStatus();    /**
-     * @brief Get a suggested move (first available move)
-     * @return A suggested move, or invalid move if none available
-     */
-    Move getSuggestedMove();
-    
-    /**
-     * @brief Get a strategic move that leads to winning
-     * @return A strategic move, or invalid move if game is unwinnable
-     */
-    Move getStrategicMove();
+    void checkGameStatus();
 
     /**
      * @brief Find the nearest peg in the specified direction
@@ -192,25 +332,8 @@ private:
      * @return Position of the nearest peg in that direction, or invalid position if none found
      */
     Position findNearestPegInDirection(int direction);
-    
-    /**
-     * @brief Check if the current board state is solvable (can reach winning condition)
-     * @return True if the board is solvable, false otherwise
-     */
-    bool isBoardSolvable();
-    
-    /**
-     * @brief Solve the board using symmetry-optimized recursive backtracking
-     * @param board Pointer to board to solve
-     * @return True if a solution exists from this state
-     */
-    bool solveBoard(Board* board);
-    
+
     /**
-     * @brief Find the best strategic move using minimax-like approach
-     * @return Best move that leads to winning, or invalid move if none exists
-     */
-    Move findBestStrategicMove();    /**
      * @brief Clear the failed board states cache for optimization
      * This should be called when starting a new game or changing board types
      */
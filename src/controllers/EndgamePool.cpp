@@ -0,0 +1,125 @@
+#include "EndgamePool.h"
+#include "controllers/StrategyWorker.h"
+#include "core/Trace.h"
+#include "utils/Logging.h"
+#include <QMutexLocker>
+#include <QRandomGenerator>
+
+// Longest take() may spend generating a position on the GUI thread
+static const int FallbackBudgetMsecs = 50;
+
+// Unmeasured positions tried by take() for one that was not handed out before
+static const int FallbackDuplicateAttempts = 16;
+
+EndgamePool::EndgamePool(QObject *parent)
+    : QThread(parent),
+      difficulty(EndgameDifficulty::Medium),
+      shuttingDown(false),
+      fallbackGenerator(nullptr)
+{
+    start(QThread::LowPriority);
+}
+
+EndgamePool::~EndgamePool()
+{
+    QMutexLocker locker(&poolMutex);
+    shuttingDown = true;
+    stopToken.requestStop(StopToken::Reason::Cancelled);
+    refillNeeded.wakeAll();
+    locker.unlock();
+
+    wait(); // Wait for thread to finish
+
+    delete fallbackGenerator;
+}
+
+QVector<QVector<PegState>> EndgamePool::take()
+{
+    PEGCORE_TRACE_SCOPE("cache", "endgame pool take");
+    QMutexLocker locker(&poolMutex);
+    if (!pool.isEmpty()) {
+        QVector<QVector<PegState>> cells = pool.takeFirst();
+        refillNeeded.wakeAll();
+        return cells;
+    }
+    EndgameTarget target = EndgameTarget::forDifficulty(difficulty);
+    locker.unlock();
+
+    qCDebug(lcEndgame) << "EndgamePool: Pool empty, generating a position on demand";
+    if (!fallbackGenerator) {
+        fallbackGenerator = new EndgameGenerator(QRandomGenerator::global()->generate(),
+                                                 &StrategyWorker::transpositionTable);
+        fallbackGenerator->shareSeenIds(&seenIds, &poolMutex);
+    }
+    // The caller is waiting: give up quickly and let the refill catch up
+    StopToken budget;
+    budget.setDeadline(FallbackBudgetMsecs);
+    QVector<QVector<PegState>> cells;
+    if (!fallbackGenerator->generate(target, cells, &budget)) {
+        // Still solvable, only the difficulty is unmeasured
+        qCDebug(lcEndgame) << "EndgamePool: No position in budget, using an unmeasured one";
+        for (int attempt = 0; attempt < FallbackDuplicateAttempts; ++attempt) {
+            Board fallback(BoardType::Endgame);
+            cells = fallback.getCells();
+            QMutexLocker seenLocker(&poolMutex);
+            if (EndgameGenerator::claimSeenId(seenIds, fallback.getBoardStateId())) {
+                break;
+            }
+        }
+    }
+    return cells;
+}
+
+void EndgamePool::setDifficulty(EndgameDifficulty difficulty)
+{
+    QMutexLocker locker(&poolMutex);
+    if (this->difficulty == difficulty) {
+        return;
+    }
+    this->difficulty = difficulty;
+    pool.clear();
+    stopToken.requestStop(StopToken::Reason::Cancelled);
+    refillNeeded.wakeAll();
+}
+
+EndgameDifficulty EndgamePool::getDifficulty()
+{
+    QMutexLocker locker(&poolMutex);
+    return difficulty;
+}
+
+void EndgamePool::run()
+{
+    pegcore::Trace::setThreadName("EndgamePool");
+    EndgameGenerator generator(QRandomGenerator::global()->generate(), &StrategyWorker::transpositionTable);
+    generator.shareSeenIds(&seenIds, &poolMutex);
+
+    forever {
+        QMutexLocker locker(&poolMutex);
+        while (pool.size() >= PoolSize && !shuttingDown) {
+            refillNeeded.wait(&poolMutex);
+        }
+        if (shuttingDown) {
+            return;
+        }
+
+        // Safe to re-arm under the lock: every stop request is made holding it
+        stopToken.reset();
+        EndgameDifficulty targetDifficulty = difficulty;
+        locker.unlock();
+
+        QVector<QVector<PegState>> cells;
+        bool found;
+        {
+            PEGCORE_TRACE_SCOPE("endgame", "generate");
+            found = generator.generate(EndgameTarget::forDifficulty(targetDifficulty), cells, &stopToken);
+        }
+
+        locker.relock();
+        if (found && targetDifficulty == difficulty) {
+            pool.append(cells);
+            qCDebug(lcEndgame) << "EndgamePool: Added position with" << generator.lastWinningLines()
+                     << "winning lines," << pool.size() << "ready";
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef ENDGAMEPOOL_H
+#define ENDGAMEPOOL_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QList>
+#include <QSet>
+#include <QVector>
+#include "models/Board.h"
+#include "models/EndgameGenerator.h"
+#include "models/StopToken.h"
+
+/**
+ * @brief Keeps a pool of generated endgame positions, refilled in the background
+ *
+ * Generating a position at the harder difficulties takes a few hundred
+ * milliseconds, too long to do when the player asks for a new endgame. The
+ * pool thread generates positions ahead of time at low priority and sleeps
+ * once PoolSize of them are waiting, so taking one is instant.
+ *
+ * Both the refill thread and the on-demand fallback of take() reject positions
+ * whose canonical id was pooled or handed out before, so endgames do not
+ * repeat, not even as a mirror image of an earlier one.
+ *
+ * Changing the difficulty drops the pooled positions and abandons the one
+ * being generated. Positions are measured against the strategy worker's
+ * shared table, so the positions proven while generating also speed up hints.
+ */
+class EndgamePool : public QThread
+{
+    Q_OBJECT
+
+public:
+    explicit EndgamePool(QObject *parent = nullptr);
+    ~EndgamePool();
+
+    /**
+     * @brief Take a position from the pool
+     *
+     * If the pool is empty, e.g. right after startup or a difficulty change,
+     * generates one on the calling thread for at most a few dozen
+     * milliseconds, then falls back to a solvable position whose difficulty
+     * is not measured.
+     *
+     * @return Endgame position on the English layout, row by row
+     */
+    QVector<QVector<PegState>> take();
+
+    /**
+     * @brief Change the difficulty of the positions handed out
+     * @param difficulty New difficulty level
+     */
+    void setDifficulty(EndgameDifficulty difficulty);
+
+    /**
+     * @brief Get the difficulty of the positions handed out
+     * @return Current difficulty level
+     */
+    EndgameDifficulty getDifficulty();
+
+protected:
+    void run() override;
+
+private:
+    // Positions kept ready before the refill thread goes to sleep
+    static constexpr int PoolSize = 8;
+
+    QMutex poolMutex;
+    QWaitCondition refillNeeded;
+    QList<QVector<QVector<PegState>>> pool;
+    QSet<quint64> seenIds;               // Canonical ids handed out or pooled, by either generator
+    EndgameDifficulty difficulty;
+    bool shuttingDown;
+    StopToken stopToken;                 // Abandons the position being generated
+    EndgameGenerator *fallbackGenerator; // Used by take() when the pool is empty
+};
+
+#endif // ENDGAMEPOOL_H
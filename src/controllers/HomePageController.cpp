@@ -1,6 +1,6 @@
 #include "controllers/HomePageController.h"
 #include <QApplication>
-#include <QDebug>
+#include "utils/Logging.h"
 
 HomePageController::HomePageController(HomePageView *view, QObject *parent)
     : QObject(parent), m_view(view)
@@ -15,12 +15,12 @@ HomePageController::HomePageController(HomePageView *view, QObject *parent)
 
 void HomePageController::onSettingsClicked()
 {
-    qDebug() << "Settings button clicked";
+    qCDebug(lcApp) << "Settings button clicked";
     emit settingsClicked(); // Emit the signal
 }
 
 void HomePageController::onQuitClicked()
 {
-    qDebug() << "Quit button clicked";
+    qCDebug(lcApp) << "Quit button clicked";
     QApplication::quit();
 }
@@ -1,21 +1,52 @@
 #include "controllers/SettingsPageController.h"
-#include <QDebug>
+#include "utils/Logging.h"
+#include <QSettings>
+
+// Settings key of the endgame difficulty, stored as its EndgameDifficulty value
+static const char *const EndgameDifficultyKey = "endgame/difficulty";
 
 SettingsPageController::SettingsPageController(SettingsPageView *view, QObject *parent)
     : QObject(parent), m_view(view)
 {
+    // Restore the saved choice before listening, so loading it is not saved back
+    int savedDifficulty = QSettings().value(EndgameDifficultyKey, static_cast<int>(EndgameDifficulty::Medium)).toInt();
+    if (savedDifficulty >= static_cast<int>(EndgameDifficulty::Easy) &&
+        savedDifficulty <= static_cast<int>(EndgameDifficulty::Hard)) {
+        m_view->setEndgameDifficulty(static_cast<EndgameDifficulty>(savedDifficulty));
+    }
+
     connect(m_view, &SettingsPageView::backClicked, this, &SettingsPageController::onBackClicked);
     connect(m_view, &SettingsPageView::fullscreenToggled, this, &SettingsPageController::onFullscreenToggled);
+    connect(m_view, &SettingsPageView::ponderToggled, this, &SettingsPageController::onPonderToggled);
+    connect(m_view, &SettingsPageView::endgameDifficultyChanged, this, &SettingsPageController::onEndgameDifficultyChanged);
+}
+
+EndgameDifficulty SettingsPageController::getEndgameDifficulty() const
+{
+    return m_view->getEndgameDifficulty();
 }
 
 void SettingsPageController::onBackClicked()
 {
-    qDebug() << "SettingsPage: Back button clicked";
+    qCDebug(lcApp) << "SettingsPage: Back button clicked";
     emit navigateToHome();
 }
 
 void SettingsPageController::onFullscreenToggled(bool checked)
 {
-    qDebug() << "SettingsPage: Fullscreen toggled -" << checked;
+    qCDebug(lcApp) << "SettingsPage: Fullscreen toggled -" << checked;
     emit setFullscreen(checked);
 }
+
+void SettingsPageController::onPonderToggled(bool checked)
+{
+    qCDebug(lcApp) << "SettingsPage: Pondering toggled -" << checked;
+    emit setPondering(checked);
+}
+
+void SettingsPageController::onEndgameDifficultyChanged(EndgameDifficulty difficulty)
+{
+    qCDebug(lcApp) << "SettingsPage: Endgame difficulty changed -" << static_cast<int>(difficulty);
+    QSettings().setValue(EndgameDifficultyKey, static_cast<int>(difficulty));
+    emit setEndgameDifficulty(difficulty);
+}
@@ -11,13 +11,23 @@ class SettingsPageController : public QObject
 public:
     explicit SettingsPageController(SettingsPageView *view, QObject *parent = nullptr);
 
+    /**
+     * @brief Get the endgame difficulty chosen by the player
+     * @return The saved choice, Medium if none was saved yet
+     */
+    EndgameDifficulty getEndgameDifficulty() const;
+
 signals:
     void navigateToHome();
     void setFullscreen(bool fullscreen);
+    void setPondering(bool enabled);
+    void setEndgameDifficulty(EndgameDifficulty difficulty);
 
 public slots:
     void onBackClicked();
     void onFullscreenToggled(bool checked);
+    void onPonderToggled(bool checked);
+    void onEndgameDifficultyChanged(EndgameDifficulty difficulty);
 
 private:
     SettingsPageView *m_view;
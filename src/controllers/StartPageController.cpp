@@ -1,6 +1,6 @@
 #include "controllers/StartPageController.h"
 #include "models/Board.h" // For BoardType
-#include <QDebug>
+#include "utils/Logging.h"
 
 StartPageController::StartPageController(StartPageView *view, QObject *parent)
     : QObject(parent), m_view(view)
@@ -11,13 +11,13 @@ StartPageController::StartPageController(StartPageView *view, QObject *parent)
 
 void StartPageController::onBackClicked()
 {
-    qDebug() << "StartPage: Back button clicked";
+    qCDebug(lcApp) << "StartPage: Back button clicked";
     emit navigateToHome();
 }
 
 void StartPageController::onGameModeSelected(BoardType boardType)
 {
-    // qDebug() << "StartPage: Game mode selected -" << boardType;
+    // qCDebug(lcApp) << "StartPage: Game mode selected -" << boardType;
     emit startGame(boardType);
     // Logic to switch to the game view with the selected mode
 }
\ No newline at end of file
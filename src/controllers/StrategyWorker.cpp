@@ -1,232 +1,540 @@
 #include "StrategyWorker.h"
-#include <QDebug>
+#include "core/Trace.h"
+#include "utils/Logging.h"
 #include <QMutexLocker>
 
 // Static member definitions for optimization
-QSet<quint64> StrategyWorker::failedBoardStates;
-QMutex StrategyWorker::failedStatesMutex;
+TranspositionTable StrategyWorker::transpositionTable;
+
+// Minimum time between two progress reports (4 Hz)
+static const int ProgressIntervalMsecs = 250;
+
+// Map a result computed on the dual board back to the requested board type
+static void mapFromDual(BoardType boardType, StrategyResult &result)
+{
+    result.move = Board::dualMove(boardType, result.move);
+    for (Move &move : result.line) {
+        move = Board::dualMove(boardType, move);
+    }
+}
 
 StrategyWorker::StrategyWorker(QObject *parent)
     : QThread(parent),
-      cancelRequested(false)
+      nextJobId(1),
+      activeJobId(0),
+      cancelRequested(false),
+      shuttingDown(false),
+      timeLimitMsecs(0),
+      searchBoard(nullptr),
+      solver(nullptr),
+      searchBoardType(BoardType::English),
+      optimizerBoard(nullptr),
+      optimizer(nullptr),
+      optimizerBoardType(BoardType::English),
+      counterBoard(nullptr),
+      counter(nullptr),
+      counterBoardType(BoardType::English),
+      progressJobId(0)
 {
 }
 
 StrategyWorker::~StrategyWorker()
 {
-    requestCancellation();
+    QMutexLocker locker(&queueMutex);
+    shuttingDown = true;
+    jobQueue.clear();
+    stopToken.requestStop(StopToken::Reason::Cancelled);
+    jobAvailable.wakeAll();
+    locker.unlock();
+
     wait(); // Wait for thread to finish
+
+    delete counter;
+    delete counterBoard;
+    delete optimizer;
+    delete optimizerBoard;
+    delete solver;
+    delete searchBoard;
+}
+
+quint64 StrategyWorker::computeStrategy(BoardType boardType, const QVector<QVector<PegState>> &boardData,
+                                        int latencyBudgetMsecs, bool refineInBackground)
+{
+    return enqueueJob({0, JobKind::Hint, boardType, boardData, latencyBudgetMsecs, refineInBackground});
+}
+
+quint64 StrategyWorker::ponder(BoardType boardType, const QVector<QVector<PegState>> &boardData)
+{
+    return enqueueJob({0, JobKind::Ponder, boardType, boardData, 0, false});
+}
+
+quint64 StrategyWorker::countSolutions(BoardType boardType, const QVector<QVector<PegState>> &boardData)
+{
+    return enqueueJob({0, JobKind::Count, boardType, boardData, 0, false});
 }
 
-void StrategyWorker::computeStrategy(BoardType boardType, const QVector<QVector<PegState>> &boardData)
+void StrategyWorker::updatePosition(BoardType boardType, const QVector<QVector<PegState>> &boardData)
 {
-    QMutexLocker locker(&cancelMutex);
-    cancelRequested = false;
-    currentBoardType = boardType;
-    currentBoardData = boardData;
+    {
+        QMutexLocker locker(&queueMutex);
+        if (activeJobId == 0 && jobQueue.isEmpty()) {
+            return;
+        }
+    }
+    enqueueJob({0, JobKind::Continue, boardType, boardData, 0, false});
+}
+
+void StrategyWorker::requestCancellation()
+{
+    QMutexLocker locker(&queueMutex);
+    jobQueue.clear();
+    if (activeJobId != 0) {
+        cancelRequested = true;
+        stopToken.requestStop(StopToken::Reason::Cancelled);
+    }
+}
+
+void StrategyWorker::setTimeLimit(int msecs)
+{
+    QMutexLocker locker(&queueMutex);
+    timeLimitMsecs = msecs;
+}
+
+quint64 StrategyWorker::enqueueJob(StrategyJob job)
+{
+    QMutexLocker locker(&queueMutex);
+    job.id = nextJobId++;
+    jobQueue.append(job);
+    if (activeJobId != 0) {
+        stopToken.requestStop(StopToken::Reason::PositionChanged);
+    }
+    jobAvailable.wakeOne();
     locker.unlock();
-    
+
+    // Started once; the thread then sleeps between jobs
     if (!isRunning()) {
         start();
     }
+    return job.id;
 }
 
-void StrategyWorker::requestCancellation()
+bool StrategyWorker::abandonIfSuperseded(quint64 jobId)
 {
-    QMutexLocker locker(&cancelMutex);
-    cancelRequested = true;
+    QMutexLocker locker(&queueMutex);
+    if (!cancelRequested && jobQueue.isEmpty() && !shuttingDown) {
+        return false;
+    }
+    // A newer request replaces the job silently; only a cancellation is reported
+    if (cancelRequested) {
+        locker.unlock();
+        emit computationCancelled(jobId);
+    }
+    return true;
 }
 
-bool StrategyWorker::isCancellationRequested()
+bool StrategyWorker::isCancellationRequested() const
 {
-    QMutexLocker locker(&cancelMutex);
-    return cancelRequested;
+    // Lock-free: a single atomic load unless a deadline is armed
+    return stopToken.stopRequested();
+}
+
+void StrategyWorker::reportStopLatency() const
+{
+    qint64 latencyNs = stopToken.stopLatencyNs();
+    if (latencyNs >= 0) {
+        qCDebug(lcStrategy) << "StrategyWorker: Search stopped" << latencyNs / 1000 << "us after request, reason"
+                 << static_cast<int>(stopToken.reason());
+    }
 }
 
 void StrategyWorker::run()
 {
-    QPair<Move, bool> result = performStrategyComputation();
-    
-    if (isCancellationRequested()) {
-        emit computationCancelled();
-    } else {
-        emit strategyComputed(result.first, result.second);
+    pegcore::Trace::setThreadName("StrategyWorker");
+    forever {
+        QMutexLocker locker(&queueMutex);
+        while (jobQueue.isEmpty() && !shuttingDown) {
+            activeJobId = 0;
+            jobAvailable.wait(&queueMutex);
+        }
+        if (shuttingDown) {
+            activeJobId = 0;
+            return;
+        }
+
+        // Only the newest request matters: older ones were made for positions
+        // the board has already left
+        StrategyJob job = jobQueue.takeLast();
+        if (!jobQueue.isEmpty()) {
+            qCDebug(lcStrategy) << "StrategyWorker: Discarding" << jobQueue.size() << "stale job(s)";
+            jobQueue.clear();
+        }
+        activeJobId = job.id;
+        cancelRequested = false;
+
+        // Safe to re-arm under the lock: every stop request is made holding it
+        stopToken.reset();
+        if (job.kind == JobKind::Hint) {
+            bool limitFirst = timeLimitMsecs > 0 &&
+                              (job.latencyBudgetMsecs == 0 || timeLimitMsecs < job.latencyBudgetMsecs);
+            stopToken.setDeadline(limitFirst ? timeLimitMsecs : job.latencyBudgetMsecs);
+        } else {
+            // Silent jobs and counts are bounded by the time limit alone
+            stopToken.setDeadline(timeLimitMsecs);
+        }
+        locker.unlock();
+
+        runJob(job);
     }
 }
 
-QPair<Move, bool> StrategyWorker::performStrategyComputation()
+void StrategyWorker::runJob(const StrategyJob &job)
 {
-    // Create a board for computation
-    Board* testBoard = new Board();
-    testBoard->initializeBoard(currentBoardType);
-    
-    // Copy the current board state
-    for (int r = 0; r < currentBoardData.size(); ++r) {
-        for (int c = 0; c < currentBoardData[r].size(); ++c) {
-            Position pos(r, c);
-            testBoard->setPegState(pos, currentBoardData[r][c]);
+    // In JobKind order
+    static const char *const jobSpanNames[] = {"hint job", "ponder job", "continue job", "count job"};
+    PEGCORE_TRACE_SCOPE("worker", jobSpanNames[static_cast<int>(job.kind)]);
+
+    // Anti-peg positions are searched as their normal-mode dual, so they get
+    // the same engine and table; moves are mapped back before reporting
+    BoardType solveType = Board::dualBoardType(job.boardType);
+    QVector<QVector<PegState>> solveData = Board::dualCells(job.boardType, job.boardData);
+
+    if (job.kind == JobKind::Count) {
+        setPriority(QThread::NormalPriority);
+        progressJobId = job.id;
+
+        SolutionCount count;
+        bool complete = performSolutionCount(solveType, solveData, count);
+        if (abandonIfSuperseded(job.id)) {
+            return;
         }
+        emit solutionsCounted(job.id, count, complete);
+        return;
+    }
+
+    qint64 jobStartNs = StopToken::nowNs();
+    bool hint = job.kind == JobKind::Hint;
+
+    // Silent jobs must not compete with the GUI thread
+    setPriority(hint ? QThread::NormalPriority : QThread::LowestPriority);
+    progressJobId = hint ? job.id : 0;
+
+    StrategyResult result = performStrategyComputation(solveType, solveData);
+    mapFromDual(job.boardType, result);
+    if (!hint) {
+        if (job.kind == JobKind::Ponder && !isCancellationRequested()) {
+            ponderChildren(solveType, solveData);
+        }
+        // Silent results only fill the table; nobody is waiting for them
+        return;
+    }
+
+    bool timedOut = stopToken.reason() == StopToken::Reason::Deadline;
+    bool anytime = job.latencyBudgetMsecs > 0;
+    if (abandonIfSuperseded(job.id)) {
+        return;
     }
-    
-    Move resultMove{Position{-1, -1}, Position{-1, -1}, Position{-1, -1}};
-    bool isDeadGame = false;
-    
+    if (timedOut && !anytime && !result.isDeadGame) {
+        // Hard time limit reached without a budget to fall back on
+        emit computationCancelled(job.id);
+        return;
+    }
+    if (!timedOut || !job.refineInBackground || !beginRefinement(jobStartNs)) {
+        emit strategyComputed(job.id, result);
+        return;
+    }
+
+    // Out of budget: hand over the best move so far, then keep working on it
+    result.isRefining = true;
+    emit strategyComputed(job.id, result);
+
+    setPriority(QThread::LowPriority);
+    progressJobId = 0;
+    result = performStrategyComputation(solveType, solveData);
+    mapFromDual(job.boardType, result);
+    if (abandonIfSuperseded(job.id)) {
+        return;
+    }
+    // Final even if unproven: the time limit may have run out first
+    emit strategyComputed(job.id, result);
+}
+
+StrategyResult StrategyWorker::performStrategyComputation(BoardType boardType, const QVector<QVector<PegState>> &boardData)
+{
+    Board rootBoard;
+    rootBoard.loadState(boardType, boardData);
+
+    StrategyResult result{{Position{-1, -1}, Position{-1, -1}, Position{-1, -1}}, false, false, -1, {}, false};
+
     try {
         // Check if cancelled before heavy computation
         if (isCancellationRequested()) {
-            testBoard->deleteLater();
-            return qMakePair(resultMove, isDeadGame);
-        }
-        
-        // Check if board is solvable first
-        if (!isBoardSolvable(testBoard)) {
-            qDebug() << "StrategyWorker: Dead game detected - no winning solution exists";
-            isDeadGame = true;
-        } else {
-            // Find the best strategic move
-            resultMove = findBestStrategicMove(testBoard);
+            if (stopToken.reason() == StopToken::Reason::Deadline) {
+                result.move = findBestEffortMove(&rootBoard);
+            }
+            return result;
+        }
+
+        // Answer straight from the table if an earlier search already proved a line
+        result.line = findKnownWinningLine(&rootBoard);
+        if (!result.line.isEmpty()) {
+            qCDebug(lcStrategy) << "StrategyWorker: Winning line answered from the transposition table";
+            result.move = result.line.first();
+            result.isProven = true;
+            result.remainingPegs = 1;
+            return result;
+        }
+
+        prepareSearch(boardType, boardData, rootBoard.getStateBits());
+        Solver::Result outcome = solver->solve(&stopToken);
+
+        if (outcome == Solver::Result::Interrupted) {
+            reportStopLatency();
+            if (stopToken.reason() == StopToken::Reason::Deadline) {
+                result.move = findBestEffortMove(&rootBoard);
+            }
+        } else if (outcome == Solver::Result::Unsolvable) {
+            qCDebug(lcStrategy) << "StrategyWorker: Dead game detected - no winning solution exists";
+            result.isDeadGame = true;
+            optimizeDeadGame(boardType, boardData, result);
+        } else if (outcome == Solver::Result::Solved) {
+            QVector<Move> line = solver->solutionLine();
+            if (!line.isEmpty()) {
+                qCDebug(lcStrategy) << "StrategyWorker: Found winning line of" << line.size() << "moves";
+                result.move = line.first();
+                result.line = line;
+                result.isProven = true;
+                result.remainingPegs = 1;
+            }
         }
     } catch (...) {
-        qDebug() << "StrategyWorker: Exception during computation";
-        isDeadGame = true;
+        qCDebug(lcStrategy) << "StrategyWorker: Exception during computation";
+        result.isDeadGame = true;
     }
-    
-    testBoard->deleteLater();
-    return qMakePair(resultMove, isDeadGame);
+
+    return result;
 }
 
-bool StrategyWorker::isBoardSolvable(Board* board)
+void StrategyWorker::optimizeDeadGame(BoardType boardType, const QVector<QVector<PegState>> &boardData,
+                                      StrategyResult &result)
 {
-    if (!board) {
-        return false;
+    PEGCORE_TRACE_SCOPE("solver", "optimize dead game");
+    if (!optimizerBoard) {
+        optimizerBoard = new Board();
     }
-    
-    // Create a copy for testing
-    Board* testBoard = new Board(board->getBoardType());
-    
-    // Copy current state
-    for (int r = 0; r < board->getRows(); ++r) {
-        for (int c = 0; c < board->getCols(); ++c) {
-            Position pos(r, c);
-            testBoard->setPegState(pos, board->getPegState(pos));
-        }
-        
-        // Check for cancellation periodically
-        if (isCancellationRequested()) {
-            testBoard->deleteLater();
-            return false;
+    if (optimizer && optimizerBoardType != boardType) {
+        delete optimizer;
+        optimizer = nullptr;
+    }
+    optimizerBoard->loadState(boardType, boardData);
+    optimizerBoardType = boardType;
+    if (!optimizer) {
+        optimizer = new PegCountOptimizer(optimizerBoard, &transpositionTable);
+    }
+
+    // Under a deadline this keeps the best line found so far
+    result.isProven = optimizer->optimize(&stopToken);
+    QVector<Move> line = optimizer->bestLine();
+    if (!line.isEmpty()) {
+        result.move = line.first();
+        if (result.isProven) {
+            result.line = line;
         }
     }
+    result.remainingPegs = optimizer->bestPieceCount();
+    qCDebug(lcStrategy) << "StrategyWorker: Fewest pieces reachable" << result.remainingPegs
+             << (result.isProven ? "(optimal)" : "(best found)");
+}
 
-    bool solvable = solveBoard(testBoard);
-    testBoard->deleteLater();
-    return solvable;
+bool StrategyWorker::performSolutionCount(BoardType boardType, const QVector<QVector<PegState>> &boardData,
+                                          SolutionCount &count)
+{
+    PEGCORE_TRACE_SCOPE("solver", "count solutions");
+    if (!counterBoard) {
+        counterBoard = new Board();
+    }
+    if (counter && counterBoardType != boardType) {
+        delete counter;
+        counter = nullptr;
+    }
+    counterBoard->loadState(boardType, boardData);
+    counterBoardType = boardType;
+    if (!counter) {
+        counter = new SolutionCounter(counterBoard, &transpositionTable);
+        counter->setProgressCallback([this](const SolverProgress &progress) {
+            if (progressJobId != 0) {
+                emit progressUpdated(progressJobId, progress);
+            }
+        }, ProgressIntervalMsecs);
+    }
+
+    qint64 startNs = StopToken::nowNs();
+    quint64 startNodes = counter->getNodesSearched();
+    bool complete = counter->count(&stopToken);
+    count = counter->result();
+    if (complete) {
+        qCDebug(lcStrategy) << "StrategyWorker: Counted" << count.toString() << "winning lines in"
+                 << (StopToken::nowNs() - startNs) / 1000000 << "ms,"
+                 << counter->getNodesSearched() - startNodes << "nodes, memo" << counter->memoSize();
+    } else {
+        reportStopLatency();
+    }
+    return complete;
 }
 
-bool StrategyWorker::solveBoard(Board* board)
+bool StrategyWorker::beginRefinement(qint64 jobStartNs)
 {
-    if (!board || isCancellationRequested()) {
+    QMutexLocker locker(&queueMutex);
+    if (cancelRequested || !jobQueue.isEmpty() || shuttingDown) {
         return false;
     }
 
-    // Check win condition
-    if (board->isWinningState()) {
-        return true;
+    qint64 remainingMsecs = 0;
+    if (timeLimitMsecs > 0) {
+        qint64 elapsedMsecs = (StopToken::nowNs() - jobStartNs) / 1000000;
+        remainingMsecs = timeLimitMsecs - elapsedMsecs;
+        if (remainingMsecs <= 0) {
+            return false;
+        }
     }
 
-    // Get unique board state identifier
-    quint64 boardStateId = board->getBoardStateId();    // Check if this board state has been flagged as unsolvable
-    {
-        QMutexLocker locker(&failedStatesMutex);
-        if (failedBoardStates.contains(boardStateId)) {
-            return false;
+    // Safe to re-arm under the lock: every stop request is made holding it
+    stopToken.reset();
+    stopToken.setDeadline(remainingMsecs);
+    return true;
+}
+
+Move StrategyWorker::findBestEffortMove(Board *board) const
+{
+    PEGCORE_TRACE_SCOPE("solver", "best-effort move");
+    if (solver && solver->getNodesSearched() > 0) {
+        Move candidate = solver->bestCandidateMove();
+        if (candidate.from.row != -1) {
+            return candidate;
         }
     }
 
-    // Get all possible moves
+    // The search never got going - fall back to the heuristic alone,
+    // skipping moves into positions already proven lost
+    Move bestMove{Position{-1, -1}, Position{-1, -1}, Position{-1, -1}};
+    int bestScore = 0;
     QVector<Move> moves = board->getValidMoves();
-    if (moves.isEmpty()) {
-        // No moves available and not in winning state - flag as failed
-        QMutexLocker locker(&failedStatesMutex);
-        failedBoardStates.insert(boardStateId);
-        return false;
+    for (const Move &move : moves) {
+        if (!board->performMove(move)) {
+            continue;
+        }
+        bool knownFailure = transpositionTable.isKnownFailure(board->getBoardStateId());
+        board->undoLastMove();
+
+        int score = Solver::scoreMove(board, move);
+        if (!knownFailure && (bestMove.from.row == -1 || score > bestScore)) {
+            bestMove = move;
+            bestScore = score;
+        }
+    }
+    if (bestMove.from.row == -1 && !moves.isEmpty()) {
+        bestMove = moves.first();
     }
+    return bestMove;
+}
+
+void StrategyWorker::ponderChildren(BoardType boardType, const QVector<QVector<PegState>> &boardData)
+{
+    PEGCORE_TRACE_SCOPE("worker", "ponder children");
+    Board rootBoard;
+    rootBoard.loadState(boardType, boardData);
 
-    // Try each move recursively
-    for (const Move& move : moves) {
-        // Check for cancellation
+    QVector<Move> moves = rootBoard.getValidMoves();
+    int solvedChildren = 0;
+    for (const Move &move : moves) {
         if (isCancellationRequested()) {
-            return false;
+            return;
         }
-        
-        // Make the move
-        if (board->performMove(move)) {
-            // Recursively check if this leads to a solution
-            if (solveBoard(board)) {
-                // Found a solution! Undo the move before returning
-                board->undoLastMove();
-                return true;
+        if (!rootBoard.performMove(move)) {
+            continue;
+        }
+
+        quint64 childId = rootBoard.getBoardStateId();
+        if (!rootBoard.isWinningState() &&
+            !transpositionTable.isKnownWin(childId) &&
+            !transpositionTable.isKnownFailure(childId)) {
+            prepareSearch(boardType, rootBoard.getCells(), rootBoard.getStateBits());
+            if (solver->solve(&stopToken) != Solver::Result::Interrupted) {
+                solvedChildren++;
             }
-            // Undo the move and try next
-            board->undoLastMove();
         }
-    }    // No solution found from this state - flag it as failed
-    {
-        QMutexLocker locker(&failedStatesMutex);
-        failedBoardStates.insert(boardStateId);
+        rootBoard.undoLastMove();
     }
-    
-    return false;
+
+    qCDebug(lcStrategy) << "StrategyWorker: Pondered" << solvedChildren << "of" << moves.size() << "child positions";
 }
 
-Move StrategyWorker::findBestStrategicMove(Board* board)
+void StrategyWorker::prepareSearch(BoardType boardType, const QVector<QVector<PegState>> &boardData, quint64 rootBits)
 {
-    if (!board || isCancellationRequested()) {
-        return {Position{-1, -1}, Position{-1, -1}, Position{-1, -1}};
+    PEGCORE_TRACE_SCOPE("worker", "prepare search");
+    if (solver && searchBoardType == boardType && solver->reroot(rootBits)) {
+        qCDebug(lcStrategy) << "StrategyWorker: Re-rooted existing search, depth" << solver->depth();
+        return;
     }
 
-    QVector<Move> allMoves = board->getValidMoves();
-    if (allMoves.isEmpty()) {
-        return {Position{-1, -1}, Position{-1, -1}, Position{-1, -1}};
+    // Position is not on the current search path - start over, keeping the tables
+    if (solver) {
+        solver->reset();
+    }
+    if (!searchBoard) {
+        searchBoard = new Board();
+    }
+    if (!solver || searchBoardType != boardType) {
+        delete solver;
+        solver = nullptr;
     }
 
-    // Test each move to see which ones lead to winning solutions
-    QVector<Move> winningMoves;
-    
-    for (const Move& move : allMoves) {
-        // Check for cancellation
-        if (isCancellationRequested()) {
-            return {Position{-1, -1}, Position{-1, -1}, Position{-1, -1}};
-        }
-        
-        // Create a test board
-        Board* testBoard = new Board(board->getBoardType());
-        
-        // Copy current state
-        for (int r = 0; r < board->getRows(); ++r) {
-            for (int c = 0; c < board->getCols(); ++c) {
-                Position pos(r, c);
-                testBoard->setPegState(pos, board->getPegState(pos));
+    searchBoard->loadState(boardType, boardData);
+    searchBoardType = boardType;
+
+    if (!solver) {
+        solver = new Solver(searchBoard, transpositionTable);
+        solver->setProgressCallback([this](const SolverProgress &progress) {
+            if (progressJobId != 0) {
+                emit progressUpdated(progressJobId, progress);
             }
-        }
+        }, ProgressIntervalMsecs);
+    }
+}
 
-        // Try this move
-        if (testBoard->performMove(move)) {
-            // Check if this state is still solvable
-            if (solveBoard(testBoard)) {
-                winningMoves.append(move);
+Move StrategyWorker::findKnownWinningMove(Board *board)
+{
+    PEGCORE_TRACE_SCOPE("cache", "known move lookup");
+    QVector<Move> moves = board->getValidMoves();
+    for (const Move &move : moves) {
+        if (board->performMove(move)) {
+            bool knownWin = board->isWinningState() ||
+                            transpositionTable.isKnownWin(board->getBoardStateId());
+            board->undoLastMove();
+            if (knownWin) {
+                return move;
             }
         }
-        
-        testBoard->deleteLater();
     }
-    
-    // Return the first winning move found, or invalid move if none guarantee win
-    if (!winningMoves.isEmpty()) {
-        qDebug() << "StrategyWorker: Found" << winningMoves.size() << "winning moves";
-        return winningMoves.first();
+    return {Position{-1, -1}, Position{-1, -1}, Position{-1, -1}};
+}
+
+QVector<Move> StrategyWorker::findKnownWinningLine(Board *board)
+{
+    QVector<Move> line;
+    while (!board->isWinningState()) {
+        Move move = findKnownWinningMove(board);
+        if (move.from.row == -1 || !board->performMove(move)) {
+            break;
+        }
+        line.append(move);
     }
 
-    qDebug() << "StrategyWorker: No guaranteed winning moves found";
-    return {Position{-1, -1}, Position{-1, -1}, Position{-1, -1}};
+    bool complete = board->isWinningState();
+    for (int i = 0; i < line.size(); ++i) {
+        board->undoLastMove();
+    }
+    if (!complete) {
+        line.clear();
+    }
+    return line;
 }
@@ -3,13 +3,63 @@
 
 #include <QThread>
 #include <QMutex>
+#include <QWaitCondition>
+#include <QList>
 #include "models/Board.h"
+#include "models/PegCountOptimizer.h"
+#include "models/SolutionCounter.h"
+#include "models/Solver.h"
+#include "models/StopToken.h"
+#include "models/TranspositionTable.h"
+
+/**
+ * @brief Outcome of a strategy computation
+ */
+struct StrategyResult
+{
+    Move move;         // Suggested move, or invalid move if none
+    bool isDeadGame;   // No single-piece finish exists from the position
+    bool isProven;     // The move provably wins, or on a dead game reaches the fewest pieces
+    int remainingPegs; // Pieces left at the end of the suggested line, -1 if unknown
+    QVector<Move> line; // Whole suggested line, starting with move; empty unless proven
+    bool isRefining;    // Still being searched; a final result or a cancellation follows
+};
 
 /**
  * @brief Worker thread for computing strategy moves in the background
- * 
+ *
  * This class runs the computationally expensive strategy calculation
  * in a separate thread to prevent UI freezing during calculation.
+ *
+ * The thread is started once and then serves a queue of jobs, sleeping while
+ * the queue is empty. Every request returns a job id and every signal carries
+ * the id of the job it belongs to, so callers can tell stale results apart.
+ * A new request supersedes the running job and any jobs still queued, since
+ * those were made for positions the board has already left.
+ *
+ * The search state survives between jobs: when the board moves on to a
+ * position that lies on the current search path, the search is re-rooted onto
+ * it instead of starting over, and all results are kept in a shared table.
+ *
+ * In ponder mode the worker solves the current position and its children at
+ * low priority while the player thinks, without reporting back, so that a
+ * later hint request is answered from the table.
+ *
+ * A request may carry a latency budget. If the search has not finished when it
+ * runs out, the most promising move found so far is reported as best effort,
+ * and the search optionally carries on at low priority to prove or replace it.
+ *
+ * When no single-piece finish exists, the worker still suggests the move of a
+ * line leaving the fewest pieces (see PegCountOptimizer).
+ *
+ * Anti-peg positions are searched as their normal-mode dual (see
+ * Board::dualBoardType()), so every job kind runs on the one optimised engine.
+ *
+ * While a requested computation runs, progressUpdated() reports the search
+ * statistics a few times per second.
+ *
+ * The worker can also count the winning lines from a position (see
+ * SolutionCounter); a count job is superseded by later requests like any other.
  */
 class StrategyWorker : public QThread
 {
@@ -20,74 +70,271 @@ public:
     ~StrategyWorker();
 
     /**
-     * @brief Start computing strategy for the given board state
+     * @brief Queue a strategy computation for the given board state
+     * @param boardType The type of board
+     * @param boardData Current board state data (row by row)
+     * @param latencyBudgetMsecs Time after which a best-effort move is reported
+     *                           if none is proven yet, 0 to wait for a proof
+     * @param refineInBackground Keep searching after a best-effort report and
+     *                           emit strategyComputed() again once proven
+     * @return Id of the job, carried by the signals reporting its results
+     */
+    quint64 computeStrategy(BoardType boardType, const QVector<QVector<PegState>> &boardData,
+                            int latencyBudgetMsecs = 0, bool refineInBackground = true);
+
+    /**
+     * @brief Queue pondering of the given board state in the background
+     *
+     * Solves the position and then each of its children at low thread priority
+     * without emitting results, until done or out of time (see
+     * setTimeLimit()). Work spent on a previous job carries over
+     * through re-rooting; a later computeStrategy() call takes over the search.
+     *
      * @param boardType The type of board
      * @param boardData Current board state data (row by row)
+     * @return Id of the job
+     */
+    quint64 ponder(BoardType boardType, const QVector<QVector<PegState>> &boardData);
+
+    /**
+     * @brief Queue counting the winning move sequences from the given board state
+     *
+     * The counts are memoised between jobs, so counting again after a move
+     * reuses the subtrees already counted.
+     *
+     * @param boardType The type of board
+     * @param boardData Board state to count from (row by row)
+     * @return Id of the job, carried by solutionsCounted()
+     */
+    quint64 countSolutions(BoardType boardType, const QVector<QVector<PegState>> &boardData);
+
+    /**
+     * @brief Move a running computation on to a new board position
+     *
+     * Queues a silent job that re-roots the running search onto the new
+     * position, keeping the work already spent on it. Does nothing if the
+     * worker is idle; the next computeStrategy() call re-roots the suspended
+     * search instead.
+     *
+     * @param boardType The type of board
+     * @param boardData New board state data (row by row)
      */
-    void computeStrategy(BoardType boardType, const QVector<QVector<PegState>> &boardData);
+    void updatePosition(BoardType boardType, const QVector<QVector<PegState>> &boardData);
 
     /**
-     * @brief Request cancellation of the current computation
+     * @brief Cancel the running job and drop all queued ones
      */
     void requestCancellation();
 
+    /**
+     * @brief Set a hard time limit after which a computation is given up
+     *
+     * Covers every job kind, including background refinement, pondering and
+     * counting. Without a latency budget, reaching the limit cancels a hint
+     * computation; a count reports itself incomplete. Takes effect from the
+     * next job.
+     *
+     * @param msecs Time limit per job in milliseconds, 0 for no limit (the default)
+     */
+    void setTimeLimit(int msecs);
+
     // Static optimization cache - shared across all instances (public for access by BoardController)
-    static QSet<quint64> failedBoardStates;
-    static QMutex failedStatesMutex;
+    static TranspositionTable transpositionTable;
 
 signals:
     /**
      * @brief Emitted when strategy computation is complete
-     * @param move The suggested move, or invalid move if no solution found
-     * @param isDeadGame True if the game is determined to be unwinnable
+     *
+     * A result with isRefining set is always followed, for the same job, by
+     * either a final result or computationCancelled(), unless a newer request
+     * supersedes the job first. A final result may still be unproven when the
+     * time limit ran out.
+     *
+     * @param jobId Id of the job returned by computeStrategy()
+     * @param result The suggested move and what is known about it
+     */
+    void strategyComputed(quint64 jobId, const StrategyResult &result);
+
+    /**
+     * @brief Emitted a few times per second while a requested computation runs
+     * @param jobId Id of the job returned by computeStrategy()
+     * @param progress Search statistics at the time of the report
+     */
+    void progressUpdated(quint64 jobId, const SolverProgress &progress);
+
+    /**
+     * @brief Emitted when a solution count finishes or reaches the time limit
+     * @param jobId Id of the job returned by countSolutions()
+     * @param count Number of winning lines, zero if the count is incomplete
+     * @param complete False if the time limit ran out before the count finished
      */
-    void strategyComputed(const Move &move, bool isDeadGame);
+    void solutionsCounted(quint64 jobId, const SolutionCount &count, bool complete);
 
     /**
-     * @brief Emitted when strategy computation is cancelled
+     * @brief Emitted when a requested computation is cancelled or times out
+     * @param jobId Id of the job returned by computeStrategy()
      */
-    void computationCancelled();
+    void computationCancelled(quint64 jobId);
 
 protected:
     void run() override;
 
 private:
-    QMutex cancelMutex;
-    bool cancelRequested;
-    BoardType currentBoardType;
-    QVector<QVector<PegState>> currentBoardData;
-    
+    enum class JobKind
+    {
+        Hint,    // Report a move for the position
+        Ponder,  // Silently solve the position and its children
+        Continue, // Silently carry the previous search on to the position
+        Count     // Report the number of winning lines from the position
+    };
+
+    struct StrategyJob
+    {
+        quint64 id;
+        JobKind kind;
+        BoardType boardType;
+        QVector<QVector<PegState>> boardData;
+        int latencyBudgetMsecs;
+        bool refineInBackground;
+    };
+
+    // Job queue, guarded by queueMutex; never touched by the search itself
+    QMutex queueMutex;
+    QWaitCondition jobAvailable;
+    QList<StrategyJob> jobQueue;
+    quint64 nextJobId;
+    quint64 activeJobId;  // Job being run, 0 when idle
+    bool cancelRequested; // The active job was cancelled
+    bool shuttingDown;
+    int timeLimitMsecs;
+
+    // Polled lock-free by the search
+    StopToken stopToken;
+
+    // Persistent search state, only touched from the worker thread
+    Board *searchBoard;
+    Solver *solver;
+    BoardType searchBoardType;
+    Board *optimizerBoard;
+    PegCountOptimizer *optimizer;
+    BoardType optimizerBoardType;
+    Board *counterBoard;
+    SolutionCounter *counter;
+    BoardType counterBoardType;
+    quint64 progressJobId; // Job whose progress is reported, 0 for none
+
     /**
-     * @brief Check if cancellation has been requested
-     * @return True if computation should be cancelled
+     * @brief Add a job to the queue and stop the job it supersedes
+     * @param job The job to run; its id is assigned here
+     * @return Id of the queued job
      */
-    bool isCancellationRequested();
-    
+    quint64 enqueueJob(StrategyJob job);
+
+    /**
+     * @brief Run a single job, emitting its results if anyone waits for them
+     * @param job The job to run
+     */
+    void runJob(const StrategyJob &job);
+
+    /**
+     * @brief Check if a newer request or a cancellation overrides the active job
+     *
+     * Emits computationCancelled() if the job was cancelled; a job replaced by
+     * a newer request ends silently.
+     *
+     * @param jobId Id of the active job
+     * @return True if the job's results are no longer wanted
+     */
+    bool abandonIfSuperseded(quint64 jobId);
+
+    /**
+     * @brief Check if the running search should stop
+     * @return True if computation was cancelled, timed out or the position changed
+     */
+    bool isCancellationRequested() const;
+
+    /**
+     * @brief Log how long the search took to honour the pending stop request
+     */
+    void reportStopLatency() const;
+
     /**
      * @brief Perform the actual strategy computation
-     * @return The computed move and whether it's a dead game
+     *
+     * If the deadline fires first, the result holds the best-effort move.
+     *
+     * @param boardType The type of board
+     * @param boardData Board state to compute a move for
+     * @return The computed move, whether it is proven and whether it's a dead game
+     */
+    StrategyResult performStrategyComputation(BoardType boardType, const QVector<QVector<PegState>> &boardData);
+
+    /**
+     * @brief Find the line leaving the fewest pieces from a dead position
+     * @param boardType The type of board
+     * @param boardData The dead position
+     * @param result Receives the first move of the line, its final piece
+     *               count and whether it is proven optimal
+     */
+    void optimizeDeadGame(BoardType boardType, const QVector<QVector<PegState>> &boardData,
+                          StrategyResult &result);
+
+    /**
+     * @brief Count the winning lines from a position
+     * @param boardType The type of board
+     * @param boardData Board state to count from
+     * @param count Receives the number of winning lines
+     * @return True if the count is complete, false if it was stopped
      */
-    QPair<Move, bool> performStrategyComputation();
-    
+    bool performSolutionCount(BoardType boardType, const QVector<QVector<PegState>> &boardData,
+                              SolutionCount &count);
+
     /**
-     * @brief Check if the board is solvable
-     * @param board The board to check
-     * @return True if solvable
+     * @brief Re-arm the stop token to refine a best-effort result
+     * @param jobStartNs When the current job started (StopToken::nowNs())
+     * @return False if the request was superseded or the time limit is spent
      */
-    bool isBoardSolvable(Board* board);
-    
+    bool beginRefinement(qint64 jobStartNs);
+
     /**
-     * @brief Solve the board using recursive backtracking
-     * @param board The board to solve
-     * @return True if a solution exists
+     * @brief Pick the most promising move when the search ran out of time
+     * @param board The root position
+     * @return Best candidate move, or invalid move if there are no moves
      */
-    bool solveBoard(Board* board);
-      /**
-     * @brief Find the best strategic move
+    Move findBestEffortMove(Board *board) const;
+
+    /**
+     * @brief Solve every child of a position to fill the transposition table
+     * @param boardType The type of board
+     * @param boardData Position whose children should be solved
+     */
+    void ponderChildren(BoardType boardType, const QVector<QVector<PegState>> &boardData);
+
+    /**
+     * @brief Point the persistent search at a new root position
+     *
+     * Re-roots the existing search when the position lies on its current path,
+     * otherwise loads the position and starts a fresh search.
+     *
+     * @param boardType The type of board
+     * @param boardData The new root position
+     * @param rootBits Exact state bits of the new root position
+     */
+    void prepareSearch(BoardType boardType, const QVector<QVector<PegState>> &boardData, quint64 rootBits);
+
+    /**
+     * @brief Look up a move leading to a position already proven winnable
      * @param board The board to analyze
-     * @return The best move, or invalid move if none found
+     * @return A winning move, or invalid move if none is known yet
+     */
+    Move findKnownWinningMove(Board *board);
+
+    /**
+     * @brief Follow known winning moves from the position to a win
+     * @param board The board to analyze; restored before returning
+     * @return The winning line, or an empty line if the table does not cover all of it
      */
-    Move findBestStrategicMove(Board* board);
+    QVector<Move> findKnownWinningLine(Board *board);
 };
 
 #endif // STRATEGYWORKER_H
@@ -0,0 +1,231 @@
+#ifndef PEGCORE_BITSTATE_H
+#define PEGCORE_BITSTATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace pegcore {
+
+/**
+ * @brief Bit set of a fixed number of 64-bit words, for layouts too large for one word
+ *
+ * Bit i lives in word i / 64. Every operation is a loop over the words with
+ * a compile-time trip count on an aligned array, which compilers unroll and
+ * turn into vector instructions where the target has them. Ordering compares
+ * from the top word down, so it matches the numeric order of a single word.
+ */
+template <int Words>
+class alignas(Words * 8 >= 32 ? 32 : Words * 8) BitState
+{
+public:
+    static constexpr int WordCount = Words;
+
+    BitState() : words{} {}
+
+    std::uint64_t word(int index) const { return words[index]; }
+    std::uint64_t &word(int index) { return words[index]; }
+
+    BitState &operator&=(const BitState &other)
+    {
+        for (int i = 0; i < Words; ++i) {
+            words[i] &= other.words[i];
+        }
+        return *this;
+    }
+
+    BitState &operator|=(const BitState &other)
+    {
+        for (int i = 0; i < Words; ++i) {
+            words[i] |= other.words[i];
+        }
+        return *this;
+    }
+
+    BitState &operator^=(const BitState &other)
+    {
+        for (int i = 0; i < Words; ++i) {
+            words[i] ^= other.words[i];
+        }
+        return *this;
+    }
+
+    BitState operator~() const
+    {
+        BitState result;
+        for (int i = 0; i < Words; ++i) {
+            result.words[i] = ~words[i];
+        }
+        return result;
+    }
+
+    friend BitState operator&(BitState a, const BitState &b) { return a &= b; }
+    friend BitState operator|(BitState a, const BitState &b) { return a |= b; }
+    friend BitState operator^(BitState a, const BitState &b) { return a ^= b; }
+
+    friend bool operator==(const BitState &a, const BitState &b)
+    {
+        std::uint64_t difference = 0;
+        for (int i = 0; i < Words; ++i) {
+            difference |= a.words[i] ^ b.words[i];
+        }
+        return difference == 0;
+    }
+
+    friend bool operator!=(const BitState &a, const BitState &b) { return !(a == b); }
+
+    friend bool operator<(const BitState &a, const BitState &b)
+    {
+        for (int i = Words - 1; i >= 0; --i) {
+            if (a.words[i] != b.words[i]) {
+                return a.words[i] < b.words[i];
+            }
+        }
+        return false;
+    }
+
+private:
+    std::uint64_t words[Words];
+};
+
+/**
+ * @brief Number of 64-bit words of a state type
+ *
+ * A layout that fits one word keeps using a plain std::uint64_t, so the
+ * common boards pay nothing for the wider types.
+ */
+template <typename State>
+constexpr int StateWordCount = State::WordCount;
+
+template <>
+constexpr int StateWordCount<std::uint64_t> = 1;
+
+// Word access shared by std::uint64_t and BitState, so the engine's
+// templates are written once for every width
+
+inline std::uint64_t stateWord(const std::uint64_t &state, int) { return state; }
+inline std::uint64_t &stateWord(std::uint64_t &state, int) { return state; }
+
+template <int Words>
+std::uint64_t stateWord(const BitState<Words> &state, int index) { return state.word(index); }
+
+template <int Words>
+std::uint64_t &stateWord(BitState<Words> &state, int index) { return state.word(index); }
+
+/**
+ * @brief Build a state from its words
+ * @param words StateWordCount<State> words, lowest first
+ * @return The state
+ */
+template <typename State>
+State stateFromWords(const std::uint64_t *words)
+{
+    State state{};
+    for (int i = 0; i < StateWordCount<State>; ++i) {
+        stateWord(state, i) = words[i];
+    }
+    return state;
+}
+
+/**
+ * @brief Get a state with a single bit set
+ * @param index The bit
+ * @return State holding only that bit
+ */
+template <typename State>
+State stateBit(int index)
+{
+    State state{};
+    stateWord(state, index >> 6) = 1ULL << (index & 63);
+    return state;
+}
+
+template <typename State>
+bool testBit(const State &state, int index)
+{
+    return (stateWord(state, index >> 6) >> (index & 63) & 1) != 0;
+}
+
+template <typename State>
+void flipBit(State &state, int index)
+{
+    stateWord(state, index >> 6) ^= 1ULL << (index & 63);
+}
+
+template <typename State>
+bool isEmpty(const State &state)
+{
+    std::uint64_t any = 0;
+    for (int i = 0; i < StateWordCount<State>; ++i) {
+        any |= stateWord(state, i);
+    }
+    return any == 0;
+}
+
+/**
+ * @brief Count the set bits
+ * @param state The state
+ * @return Number of bits set
+ */
+template <typename State>
+int popCount(const State &state)
+{
+    int count = 0;
+    for (int i = 0; i < StateWordCount<State>; ++i) {
+#if defined(__GNUC__) || defined(__clang__)
+        count += __builtin_popcountll(stateWord(state, i));
+#else
+        for (std::uint64_t bits = stateWord(state, i); bits != 0; bits &= bits - 1) {
+            count++;
+        }
+#endif
+    }
+    return count;
+}
+
+/**
+ * @brief Get the index of the lowest set bit of a word
+ * @param bits Non-zero word
+ * @return Index of the lowest bit set
+ */
+inline int lowestBit(std::uint64_t bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bits);
+#else
+    int index = 0;
+    for (; (bits & 1) == 0; bits >>= 1) {
+        index++;
+    }
+    return index;
+#endif
+}
+
+/**
+ * @brief Hash of a state, for the transposition table
+ *
+ * A single word keeps std::hash; wider states fold their words together with
+ * a multiplicative mix so every word affects the bucket.
+ */
+template <typename State>
+struct StateHash
+{
+    std::size_t operator()(const State &state) const
+    {
+        std::uint64_t hash = 0;
+        for (int i = 0; i < StateWordCount<State>; ++i) {
+            hash = (hash ^ stateWord(state, i)) * 0x9E3779B97F4A7C15ULL;
+            hash ^= hash >> 29;
+        }
+        return std::size_t(hash);
+    }
+};
+
+template <>
+struct StateHash<std::uint64_t> : std::hash<std::uint64_t>
+{
+};
+
+} // namespace pegcore
+
+#endif // PEGCORE_BITSTATE_H
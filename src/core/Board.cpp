@@ -0,0 +1,191 @@
+#include "core/Board.h"
+#include <cassert>
+
+namespace pegcore {
+
+template <typename State>
+BasicBoard<State>::BasicBoard(const Layout &layout, Rules rules, const State &pegs)
+    : shape(&layout),
+      moveRules(rules),
+      occupied(pegs & layout.allCells<State>()),
+      moveCount(0)
+{
+    assert(layout.stateWords() == StateWordCount<State>);
+    played.reserve(layout.cellCount());
+    moveCount = countMoves();
+}
+
+template <typename State>
+BasicBoard<State> BasicBoard<State>::starting(Variant variant)
+{
+    switch (variant) {
+        case Variant::Diamond: {
+            const Layout &layout = Layout::diamond();
+            return BasicBoard(layout, Rules::Normal, layout.allCells<State>() & ~stateBit<State>(layout.cellAt(3, 3)));
+        }
+        case Variant::Square: {
+            const Layout &layout = Layout::square();
+            return BasicBoard(layout, Rules::Normal, layout.allCells<State>() & ~stateBit<State>(layout.cellAt(2, 3)));
+        }
+        case Variant::AntiPeg: {
+            // Only the centre peg; the goal is to fill the board
+            const Layout &layout = Layout::english();
+            return BasicBoard(layout, Rules::AntiPeg, stateBit<State>(layout.cellAt(3, 3)));
+        }
+        case Variant::English:
+            break;
+    }
+    const Layout &layout = Layout::english();
+    return BasicBoard(layout, Rules::Normal, layout.allCells<State>() & ~stateBit<State>(layout.cellAt(3, 3)));
+}
+
+template <typename State>
+void BasicBoard<State>::setCell(int index, Cell state)
+{
+    if (testBit(occupied, index) == (state == Cell::Peg)) {
+        return;
+    }
+
+    int movesBefore = countMovesThrough(index);
+    flipBit(occupied, index);
+    moveCount += countMovesThrough(index) - movesBefore;
+}
+
+template <typename State>
+void BasicBoard<State>::setPegs(const State &pegs)
+{
+    occupied = pegs & shape->allCells<State>();
+    played.clear();
+    moveCount = countMoves();
+}
+
+template <typename State>
+bool BasicBoard<State>::isWin() const
+{
+    if (moveRules == Rules::AntiPeg) {
+        return moveCount == 0 && emptyCount() == 1;
+    }
+    return pegCount() == 1;
+}
+
+template <typename State>
+bool BasicBoard<State>::isLegal(const Move &move) const
+{
+    return shape->jumpIndex(move) >= 0 && isOpen(move);
+}
+
+template <typename State>
+int BasicBoard<State>::generateMoves(Move *out) const
+{
+    // Only cells holding a peg can start a move; visit them in cell order
+    int count = 0;
+    for (int word = 0; word < StateWordCount<State>; ++word) {
+        for (std::uint64_t pending = stateWord(occupied, word); pending != 0; pending &= pending - 1) {
+            int from = word * 64 + lowestBit(pending);
+            for (const Move *move = shape->jumpsFromBegin(from); move != shape->jumpsFromEnd(from); ++move) {
+                if (isOpen(*move)) {
+                    out[count++] = *move;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+template <typename State>
+bool BasicBoard<State>::play(const Move &move)
+{
+    int jump = shape->jumpIndex(move);
+    if (jump < 0 || !isOpen(move)) {
+        return false;
+    }
+    played.push_back(std::uint16_t(jump));
+    toggle(jump);
+    return true;
+}
+
+template <typename State>
+bool BasicBoard<State>::undo()
+{
+    if (played.empty()) {
+        return false;
+    }
+    toggle(played.back());
+    played.pop_back();
+    return true;
+}
+
+template <typename State>
+State BasicBoard<State>::canonicalId() const
+{
+    // The tag takes the top bits of the last word, above every cell
+    std::uint64_t tag = std::uint64_t(shape->tag()) << 1 | (moveRules == Rules::AntiPeg);
+    State id = shape->canonical(occupied);
+    stateWord(id, StateWordCount<State> - 1) |= tag << (64 - Layout::TagBits);
+    return id;
+}
+
+template <typename State>
+BasicBoard<State> BasicBoard<State>::dual() const
+{
+    if (moveRules != Rules::AntiPeg) {
+        return BasicBoard(*shape, moveRules, occupied);
+    }
+    return BasicBoard(*shape, Rules::Normal, ~occupied);
+}
+
+template <typename State>
+Move BasicBoard<State>::dualMove(Rules rules, const Move &move)
+{
+    if (rules != Rules::AntiPeg) {
+        return move;
+    }
+    return {move.to, move.over, move.from};
+}
+
+template <typename State>
+int BasicBoard<State>::countMovesThrough(int index) const
+{
+    int count = 0;
+    const std::vector<Move> &jumps = shape->jumps();
+    for (const std::uint16_t *jump = shape->jumpsThroughBegin(index); jump != shape->jumpsThroughEnd(index); ++jump) {
+        count += isOpen(jumps[*jump]);
+    }
+    return count;
+}
+
+template <typename State>
+int BasicBoard<State>::countMoves() const
+{
+    int count = 0;
+    for (const Move &move : shape->jumps()) {
+        count += isOpen(move);
+    }
+    return count;
+}
+
+template <typename State>
+void BasicBoard<State>::toggle(int jump)
+{
+    const std::vector<Move> &jumps = shape->jumps();
+    const Move &move = jumps[jump];
+    const std::uint16_t *begin = shape->jumpsAffectedBegin(jump);
+    const std::uint16_t *end = shape->jumpsAffectedEnd(jump);
+
+    int movesBefore = 0;
+    for (const std::uint16_t *affected = begin; affected != end; ++affected) {
+        movesBefore += isOpen(jumps[*affected]);
+    }
+    occupied ^= stateBit<State>(move.from) | stateBit<State>(move.over) | stateBit<State>(move.to);
+    int movesAfter = 0;
+    for (const std::uint16_t *affected = begin; affected != end; ++affected) {
+        movesAfter += isOpen(jumps[*affected]);
+    }
+    moveCount += movesAfter - movesBefore;
+}
+
+template class BasicBoard<std::uint64_t>;
+template class BasicBoard<BitState<2>>;
+template class BasicBoard<BitState<4>>;
+
+} // namespace pegcore
@@ -0,0 +1,235 @@
+#ifndef PEGCORE_BOARD_H
+#define PEGCORE_BOARD_H
+
+#include <cstdint>
+#include <vector>
+#include "core/Layout.h"
+
+namespace pegcore {
+
+enum class Cell : std::uint8_t
+{
+    Empty,
+    Peg
+};
+
+enum class Rules : std::uint8_t
+{
+    Normal,  // A peg jumps over a peg into a hole, removing the jumped peg
+    AntiPeg  // A peg jumps over a hole into a hole, filling the jumped hole
+};
+
+/**
+ * @brief The standard starting positions
+ */
+enum class Variant
+{
+    English,
+    Diamond,
+    Square,
+    AntiPeg  // English layout, centre peg only, anti-peg rules
+};
+
+/**
+ * @brief A position on a layout, with its rules and move history
+ *
+ * The pegs are a bit set over the layout's cells: a single 64-bit word on
+ * the standard boards (Board), a BitState on layouts of more than 58 cells.
+ * State must be the layout's state type (see Layout::stateWords()). Peg count
+ * and mobility (number of legal moves) are kept up to date on every change,
+ * which makes the game-over and win checks O(1).
+ */
+template <typename State>
+class BasicBoard
+{
+public:
+    /**
+     * @brief Create a position
+     * @param layout Layout of the board; must outlive the position
+     * @param rules Rules moves are played under
+     * @param pegs Occupied cells, one bit per cell
+     */
+    BasicBoard(const Layout &layout, Rules rules, const State &pegs = State());
+
+    /**
+     * @brief Get the starting position of a standard variant
+     * @param variant The variant
+     * @return Position with an empty history
+     */
+    static BasicBoard starting(Variant variant);
+
+    const Layout &layout() const { return *shape; }
+    Rules rules() const { return moveRules; }
+
+    /**
+     * @brief Get the exact position, without symmetry reduction
+     * @return Occupied cells, one bit per cell
+     */
+    const State &pegs() const { return occupied; }
+
+    Cell cell(int index) const { return testBit(occupied, index) ? Cell::Peg : Cell::Empty; }
+
+    /**
+     * @brief Change a single cell, keeping the counters up to date
+     * @param index The cell
+     * @param state New state
+     */
+    void setCell(int index, Cell state);
+
+    /**
+     * @brief Replace the whole position and forget the move history
+     * @param pegs Occupied cells, one bit per cell
+     */
+    void setPegs(const State &pegs);
+
+    int pegCount() const { return popCount(occupied); }
+    int emptyCount() const { return shape->cellCount() - pegCount(); }
+
+    /**
+     * @brief Count the legal moves of the position
+     * @return Number of moves generateMoves() would write
+     */
+    int mobility() const { return moveCount; }
+
+    bool isGameOver() const { return moveCount == 0; }
+
+    /**
+     * @brief Check if the position is won
+     *
+     * Normal rules win on a single peg; anti-peg rules win when no move is
+     * left and a single hole remains.
+     *
+     * @return True if the position is won
+     */
+    bool isWin() const;
+
+    /**
+     * @brief Check if a move is legal in the position
+     * @param move The move
+     * @return True if it is a jump of the layout and the cells allow it
+     */
+    bool isLegal(const Move &move) const;
+
+    /**
+     * @brief Write all legal moves into a caller-provided buffer
+     *
+     * Moves are ordered by starting cell, then up, down, left, right.
+     *
+     * @param out Buffer with room for at least maxMoveCount() moves
+     * @return Number of moves written
+     */
+    int generateMoves(Move *out) const;
+
+    /**
+     * @brief Upper bound on the number of moves of any position of the layout
+     * @return Number of jumps of the layout
+     */
+    int maxMoveCount() const { return int(shape->jumps().size()); }
+
+    /**
+     * @brief Play a move and record it in the history
+     * @param move The move
+     * @return False, leaving the position unchanged, if the move is illegal
+     */
+    bool play(const Move &move);
+
+    /**
+     * @brief Take back the last move played
+     * @return False if the history is empty
+     */
+    bool undo();
+
+    /**
+     * @brief Count the moves in the history
+     * @return Number of moves undo() can take back
+     */
+    int historySize() const { return int(played.size()); }
+
+    /**
+     * @brief Get the last move played
+     * @return The move undo() would take back; historySize() must not be 0
+     */
+    const Move &lastMove() const { return shape->jumps()[played.back()]; }
+
+    /**
+     * @brief Get the id shared by all symmetric variants of the position
+     *
+     * The bits above the cells tag the layout and rules, so positions of
+     * different layouts or rules never share an id.
+     *
+     * @return Canonical state id
+     */
+    State canonicalId() const;
+
+    /**
+     * @brief Get the position whose solutions mirror this one's under normal rules
+     *
+     * Anti-peg is normal solitaire played backwards: complementing a position
+     * turns every anti-peg move into a normal move with from and to swapped,
+     * and the anti-peg win (one hole) into the normal win (one peg).
+     *
+     * @return The complemented position under normal rules for anti-peg,
+     *         otherwise a copy of the position; the history is not carried over
+     */
+    BasicBoard dual() const;
+
+    /**
+     * @brief Map a move between a position and its dual (see dual())
+     * @param rules Rules of the position being played
+     * @param move The move to map; the mapping is its own inverse
+     * @return The move with from and to swapped for anti-peg, otherwise unchanged
+     */
+    static Move dualMove(Rules rules, const Move &move);
+
+private:
+    const Layout *shape;
+    Rules moveRules;
+    State occupied;
+    int moveCount;
+    std::vector<std::uint16_t> played; // History, as indices into the layout's jumps
+
+    bool isOpen(const Move &move) const
+    {
+        // Peg on from, hole on to, and on the jumped cell a peg under normal
+        // rules or a hole under anti-peg; branch-free, as most calls fail
+        std::uint64_t overFlip = moveRules == Rules::AntiPeg;
+        std::uint64_t from = stateWord(occupied, move.from >> 6) >> (move.from & 63);
+        std::uint64_t over = stateWord(occupied, move.over >> 6) >> (move.over & 63);
+        std::uint64_t to = stateWord(occupied, move.to >> 6) >> (move.to & 63);
+        return (from & (over ^ overFlip) & ~to & 1) != 0;
+    }
+
+    /**
+     * @brief Count the legal moves that start at, pass over or land on a cell
+     *
+     * Changing one cell only changes those moves, so mobility is updated by
+     * the difference of this count before and after the change.
+     *
+     * @param index The cell
+     * @return Number of legal moves through the cell
+     */
+    int countMovesThrough(int index) const;
+    int countMoves() const;
+
+    /**
+     * @brief Play or take back a jump
+     *
+     * Under either rules a move flips exactly its three cells, so playing and
+     * taking back are the same operation. Only jumps sharing a cell with it
+     * can change, so mobility is recounted over those alone.
+     *
+     * @param jump Index into the layout's jumps
+     */
+    void toggle(int jump);
+};
+
+// Positions of the standard boards, which all fit a single word
+using Board = BasicBoard<std::uint64_t>;
+
+extern template class BasicBoard<std::uint64_t>;
+extern template class BasicBoard<BitState<2>>;
+extern template class BasicBoard<BitState<4>>;
+
+} // namespace pegcore
+
+#endif // PEGCORE_BOARD_H
@@ -0,0 +1,226 @@
+#include "core/Layout.h"
+#include <algorithm>
+#include <cassert>
+
+namespace pegcore {
+
+Layout::Layout(const std::vector<std::string> &diagram, int tag)
+    : rowCount(int(diagram.size())),
+      colCount(0),
+      layoutTag(tag),
+      wordCount(1),
+      symmetries(0),
+      byteCount(0)
+{
+    for (const std::string &row : diagram) {
+        colCount = std::max(colCount, int(row.size()));
+    }
+
+    cellIndex.assign(rowCount * colCount, -1);
+    for (int r = 0; r < rowCount; ++r) {
+        for (int c = 0; c < int(diagram[r].size()); ++c) {
+            if (diagram[r][c] == '-' || diagram[r][c] == ' ') {
+                continue;
+            }
+            cellIndex[r * colCount + c] = cellCount();
+            cellRows.push_back(r);
+            cellCols.push_back(c);
+        }
+    }
+    assert(cellCount() <= MaxCells && tag >= 0 && tag < 16);
+    while (cellCount() > wordCount * 64 - TagBits) {
+        wordCount *= 2;
+    }
+    cellMask.assign(wordCount, 0);
+    for (int cell = 0; cell < cellCount(); ++cell) {
+        cellMask[cell / 64] |= 1ULL << (cell % 64);
+    }
+
+    findJumps();
+    findSymmetries();
+}
+
+const Layout &Layout::english()
+{
+    static const Layout layout({
+        "--ooo--",
+        "--ooo--",
+        "ooooooo",
+        "ooooooo",
+        "ooooooo",
+        "--ooo--",
+        "--ooo--",
+    }, 0);
+    return layout;
+}
+
+const Layout &Layout::diamond()
+{
+    static const Layout layout({
+        "---o---",
+        "--ooo--",
+        "-ooooo-",
+        "ooooooo",
+        "ooooooo",
+        "-ooooo-",
+        "--ooo--",
+        "---o---",
+    }, 1);
+    return layout;
+}
+
+const Layout &Layout::square()
+{
+    static const Layout layout({
+        "oooooo",
+        "oooooo",
+        "oooooo",
+        "oooooo",
+        "oooooo",
+        "oooooo",
+    }, 2);
+    return layout;
+}
+
+int Layout::jumpIndex(const Move &move) const
+{
+    if (move.from >= cellCount()) {
+        return -1;
+    }
+    const Move *end = jumpsFromEnd(move.from);
+    const Move *jump = std::find(jumpsFromBegin(move.from), end, move);
+    return jump != end ? int(jump - allJumps.data()) : -1;
+}
+
+template <typename State>
+State Layout::transform(int symmetry, const State &bits) const
+{
+    // The table stride is the state's width, which is the layout's
+    constexpr int Words = StateWordCount<State>;
+    const std::uint64_t *table = transformTables.data() + std::size_t(symmetry) * byteCount * 256 * Words;
+    State image{};
+    std::uint64_t word = stateWord(bits, 0);
+    for (int i = 0; i < byteCount; ++i, word >>= 8, table += 256 * Words) {
+        if (Words > 1 && i % 8 == 0) {
+            word = stateWord(bits, i / 8);
+        }
+        image |= stateFromWords<State>(table + (word & 0xff) * Words);
+    }
+    return image;
+}
+
+template <typename State>
+State Layout::canonical(const State &bits) const
+{
+    State smallest = bits;
+    for (int symmetry = 1; symmetry < symmetries; ++symmetry) {
+        State image = transform(symmetry, bits);
+        smallest = image < smallest ? image : smallest;
+    }
+    return smallest;
+}
+
+template std::uint64_t Layout::transform(int, const std::uint64_t &) const;
+template BitState<2> Layout::transform(int, const BitState<2> &) const;
+template BitState<4> Layout::transform(int, const BitState<4> &) const;
+template std::uint64_t Layout::canonical(const std::uint64_t &) const;
+template BitState<2> Layout::canonical(const BitState<2> &) const;
+template BitState<4> Layout::canonical(const BitState<4> &) const;
+
+void Layout::findJumps()
+{
+    static const int dr[] = {-1, 1, 0, 0};
+    static const int dc[] = {0, 0, -1, 1};
+
+    std::vector<std::vector<std::uint16_t>> through(cellCount());
+    neighbourMasks.assign(std::size_t(cellCount()) * wordCount, 0);
+    fromOffsets.push_back(0);
+    for (int cell = 0; cell < cellCount(); ++cell) {
+        int r = cellRows[cell];
+        int c = cellCols[cell];
+        for (int d = 0; d < 4; ++d) {
+            int over = cellAt(r + dr[d], c + dc[d]);
+            int to = cellAt(r + 2 * dr[d], c + 2 * dc[d]);
+            if (over >= 0) {
+                neighbourMasks[cell * wordCount + over / 64] |= 1ULL << (over % 64);
+            }
+            if (over < 0 || to < 0) {
+                continue;
+            }
+            std::uint16_t index = std::uint16_t(allJumps.size());
+            allJumps.push_back({CellIndex(cell), CellIndex(over), CellIndex(to)});
+            through[cell].push_back(index);
+            through[over].push_back(index);
+            through[to].push_back(index);
+        }
+        fromOffsets.push_back(int(allJumps.size()));
+    }
+
+    throughOffsets.push_back(0);
+    for (const std::vector<std::uint16_t> &list : through) {
+        throughJumps.insert(throughJumps.end(), list.begin(), list.end());
+        throughOffsets.push_back(int(throughJumps.size()));
+    }
+
+    affectedOffsets.push_back(0);
+    for (const Move &jump : allJumps) {
+        std::vector<std::uint16_t> affected;
+        for (int cell : {jump.from, jump.over, jump.to}) {
+            affected.insert(affected.end(), through[cell].begin(), through[cell].end());
+        }
+        std::sort(affected.begin(), affected.end());
+        affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+        affectedJumps.insert(affectedJumps.end(), affected.begin(), affected.end());
+        affectedOffsets.push_back(int(affectedJumps.size()));
+    }
+}
+
+void Layout::findSymmetries()
+{
+    // Try the eight transforms of the square (an optional horizontal flip,
+    // then 0-3 quarter turns clockwise) and keep those that map every cell
+    // onto a cell; the identity comes first
+    std::vector<std::vector<int>> permutations;
+    for (int flip = 0; flip < 2; ++flip) {
+        for (int turns = 0; turns < 4; ++turns) {
+            std::vector<int> permutation(cellCount());
+            bool valid = true;
+            for (int cell = 0; cell < cellCount() && valid; ++cell) {
+                int r = cellRows[cell];
+                int c = flip ? colCount - 1 - cellCols[cell] : cellCols[cell];
+                int height = rowCount;
+                for (int i = 0; i < turns; ++i) {
+                    int turnedRow = c;
+                    c = height - 1 - r;
+                    r = turnedRow;
+                    height = height == rowCount ? colCount : rowCount;
+                }
+                permutation[cell] = cellAt(r, c);
+                valid = permutation[cell] >= 0 && (turns % 2 == 0 || rowCount == colCount);
+            }
+            if (valid && std::find(permutations.begin(), permutations.end(), permutation) == permutations.end()) {
+                permutations.push_back(permutation);
+            }
+        }
+    }
+
+    symmetries = int(permutations.size());
+    byteCount = (cellCount() + 7) / 8;
+    transformTables.assign(std::size_t(symmetries) * byteCount * 256 * wordCount, 0);
+    for (int symmetry = 0; symmetry < symmetries; ++symmetry) {
+        for (int byte = 0; byte < byteCount; ++byte) {
+            std::uint64_t *table = transformTables.data() + (std::size_t(symmetry) * byteCount + byte) * 256 * wordCount;
+            for (int value = 0; value < 256; ++value) {
+                for (int bit = 0; bit < 8; ++bit) {
+                    int cell = byte * 8 + bit;
+                    if ((value >> bit & 1) && cell < cellCount()) {
+                        int image = permutations[symmetry][cell];
+                        table[value * wordCount + image / 64] |= 1ULL << (image % 64);
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace pegcore
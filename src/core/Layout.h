@@ -0,0 +1,259 @@
+#ifndef PEGCORE_LAYOUT_H
+#define PEGCORE_LAYOUT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "core/BitState.h"
+
+/**
+ * @brief Qt-free game engine: layouts, rules, positions and the solver
+ *
+ * Everything in this namespace uses only the C++ standard library, so the
+ * engine runs unchanged in the game, the command-line tools and on machines
+ * without Qt. The Qt models (Board, Solver) are thin adapters over it.
+ */
+namespace pegcore {
+
+// Cell indices fit a byte: a layout has at most Layout::MaxCells cells
+using CellIndex = std::uint8_t;
+
+/**
+ * @brief A jump between three cells in a line, by cell index
+ */
+struct Move
+{
+    CellIndex from;
+    CellIndex over;
+    CellIndex to;
+
+    bool operator==(const Move &other) const
+    {
+        return from == other.from && over == other.over && to == other.to;
+    }
+};
+
+/**
+ * @brief Shape of a board: its playable cells, the jumps between them and its symmetries
+ *
+ * Playable cells are numbered row by row from 0, and a position stores one bit
+ * per cell under that numbering. Everything derived from the shape (jumps,
+ * neighbours, symmetry permutations) is precomputed once, so positions only
+ * ever do table lookups and bit operations.
+ *
+ * A position is a single std::uint64_t on layouts of up to 58 cells and a
+ * BitState of 2 or 4 words on larger ones (see stateWords()). The masks and
+ * symmetry tables are kept at the layout's width, and their accessors are
+ * templates on the state type, which must have exactly that width.
+ *
+ * Only the transforms of the square's symmetry group that map the layout onto
+ * itself count as symmetries. A non-square layout such as the 8x7 diamond has
+ * no 90-degree symmetry, and rotating it anyway would merge distinct positions.
+ */
+class Layout
+{
+public:
+    // The top bits of a state id's last word tag it with its layout and rules
+    static constexpr int TagBits = 6;
+    static constexpr int MaxStateWords = 4;
+    static constexpr int MaxCells = MaxStateWords * 64 - TagBits;
+
+    /**
+     * @brief Build a layout from a diagram
+     * @param diagram One string per row; '-' or ' ' marks a cell outside the
+     *                board, any other character a playable cell
+     * @param tag Small number identifying the layout in state ids (0-15);
+     *            layouts sharing a transposition table need distinct tags
+     */
+    Layout(const std::vector<std::string> &diagram, int tag);
+
+    /**
+     * @brief The 33-hole English cross
+     */
+    static const Layout &english();
+
+    /**
+     * @brief The 32-hole diamond, 8 rows by 7 columns
+     */
+    static const Layout &diamond();
+
+    /**
+     * @brief The 6x6 square
+     */
+    static const Layout &square();
+
+    int rows() const { return rowCount; }
+    int cols() const { return colCount; }
+    int tag() const { return layoutTag; }
+
+    /**
+     * @brief Count the playable cells
+     * @return Number of cells, at most MaxCells
+     */
+    int cellCount() const { return int(cellRows.size()); }
+
+    /**
+     * @brief Count the 64-bit words of a position of this layout
+     *
+     * The fewest of 1, 2 or 4 words that hold the cells and the tag bits;
+     * positions use std::uint64_t for 1 word and BitState otherwise.
+     *
+     * @return Word count of the layout's state type
+     */
+    int stateWords() const { return wordCount; }
+
+    /**
+     * @brief Get the bit set with one bit per playable cell
+     * @return Mask of all cells
+     */
+    template <typename State = std::uint64_t>
+    State allCells() const { return stateFromWords<State>(cellMask.data()); }
+
+    /**
+     * @brief Map a grid position to its cell
+     * @param row Grid row, may be out of range
+     * @param col Grid column, may be out of range
+     * @return Cell index, or -1 if the position is not on the board
+     */
+    int cellAt(int row, int col) const
+    {
+        if (row < 0 || row >= rowCount || col < 0 || col >= colCount) {
+            return -1;
+        }
+        return cellIndex[row * colCount + col];
+    }
+
+    int rowOf(int cell) const { return cellRows[cell]; }
+    int colOf(int cell) const { return cellCols[cell]; }
+
+    /**
+     * @brief Get every jump of the layout, regardless of position
+     *
+     * Ordered by starting cell, then up, down, left, right; move generation
+     * follows the same order.
+     *
+     * @return All jumps
+     */
+    const std::vector<Move> &jumps() const { return allJumps; }
+
+    /**
+     * @brief Get the jumps starting at a cell
+     * @param cell The starting cell
+     * @return Range [first, last) into jumps()
+     */
+    const Move *jumpsFromBegin(int cell) const { return allJumps.data() + fromOffsets[cell]; }
+    const Move *jumpsFromEnd(int cell) const { return allJumps.data() + fromOffsets[cell + 1]; }
+
+    /**
+     * @brief Get the jumps that start at, pass over or land on a cell
+     * @param cell The cell
+     * @return Range [first, last) of indices into jumps()
+     */
+    const std::uint16_t *jumpsThroughBegin(int cell) const { return throughJumps.data() + throughOffsets[cell]; }
+    const std::uint16_t *jumpsThroughEnd(int cell) const { return throughJumps.data() + throughOffsets[cell + 1]; }
+
+    /**
+     * @brief Find a move among the jumps of this layout
+     * @param move The move
+     * @return Index into jumps(), or -1 if the three cells do not lie next to
+     *         each other in a line
+     */
+    int jumpIndex(const Move &move) const;
+
+    /**
+     * @brief Get the jumps whose legality can change when a jump is played
+     *
+     * Those sharing a cell with it, each listed once.
+     *
+     * @param jump Index into jumps()
+     * @return Range [first, last) of indices into jumps()
+     */
+    const std::uint16_t *jumpsAffectedBegin(int jump) const { return affectedJumps.data() + affectedOffsets[jump]; }
+    const std::uint16_t *jumpsAffectedEnd(int jump) const { return affectedJumps.data() + affectedOffsets[jump + 1]; }
+
+    /**
+     * @brief Get the orthogonal neighbours of a cell
+     * @param cell The cell
+     * @return Bit set of the up to four adjacent cells
+     */
+    template <typename State = std::uint64_t>
+    State neighbours(int cell) const { return stateFromWords<State>(neighbourMasks.data() + cell * wordCount); }
+
+    /**
+     * @brief Count the symmetries, including the identity
+     * @return Number of transforms mapping the layout onto itself (1-8)
+     */
+    int symmetryCount() const { return symmetries; }
+
+    /**
+     * @brief Apply a symmetry to a position
+     * @param symmetry Index below symmetryCount(); 0 is the identity
+     * @param bits Position, one bit per cell
+     * @return The transformed position
+     */
+    template <typename State>
+    State transform(int symmetry, const State &bits) const;
+
+    /**
+     * @brief Get the smallest of a position's symmetric images
+     *
+     * Costs one table lookup per byte of the position and symmetry.
+     *
+     * @param bits Position, one bit per cell
+     * @return Canonical form shared by all symmetric positions
+     */
+    template <typename State>
+    State canonical(const State &bits) const;
+
+private:
+    int rowCount;
+    int colCount;
+    int layoutTag;
+    int wordCount;
+    std::vector<std::uint64_t> cellMask;  // wordCount words
+    std::vector<int> cellIndex; // Per grid position, -1 outside the board
+    std::vector<int> cellRows;
+    std::vector<int> cellCols;
+    std::vector<Move> allJumps;
+    std::vector<int> fromOffsets;         // Per cell, into allJumps
+    std::vector<std::uint16_t> throughJumps;
+    std::vector<int> throughOffsets;      // Per cell, into throughJumps
+    std::vector<std::uint16_t> affectedJumps;
+    std::vector<int> affectedOffsets;     // Per jump, into affectedJumps
+    std::vector<std::uint64_t> neighbourMasks; // Per cell, wordCount words
+
+    // Per symmetry and byte of the position, the image of every byte value
+    // (wordCount words each); the image of a position is the OR over its bytes
+    int symmetries;
+    int byteCount;
+    std::vector<std::uint64_t> transformTables;
+
+    void findJumps();
+    void findSymmetries();
+};
+
+/**
+ * @brief Call a function with a value of the state type of a layout
+ *
+ * Code generic over the state width is written once as a template (or a
+ * generic lambda taking the state by value) and dispatched here on the
+ * layout's size, so each width runs fully specialised code.
+ *
+ * @param layout The layout
+ * @param function Called with a default-constructed std::uint64_t,
+ *                 BitState<2> or BitState<4>
+ * @return What the function returns
+ */
+template <typename Function>
+decltype(auto) withStateType(const Layout &layout, Function &&function)
+{
+    switch (layout.stateWords()) {
+        case 1: return function(std::uint64_t());
+        case 2: return function(BitState<2>());
+        default: return function(BitState<4>());
+    }
+}
+
+} // namespace pegcore
+
+#endif // PEGCORE_LAYOUT_H
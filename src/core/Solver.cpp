@@ -0,0 +1,386 @@
+#include "core/Solver.h"
+#include "core/Trace.h"
+#include <algorithm>
+#include <limits>
+
+namespace pegcore {
+
+template <typename State>
+BasicSolver<State>::BasicSolver(BasicBoard<State> *board, BasicTranspositionTable<State> &table)
+    : board(board),
+      table(table),
+      baseFrame(0),
+      frameCount(0),
+      appliedMoves(0),
+      maxMovesPerPly(0),
+      solved(false),
+      nodesSearched(0),
+      stats(nullptr),
+      searchElapsedNs(0),
+      progressIntervalNs(0),
+      nextProgressNs(0),
+      lastProgressNs(StopToken::nowNs()),
+      lastProgressNodes(0),
+      lastProgressProbes(0),
+      lastProgressHits(0),
+      tracedRootMove(-1),
+      tracedRootMoveStartNs(0)
+{
+    if (!board) {
+        return;
+    }
+
+    // Every move adds or removes exactly one peg, so no line can be longer
+    // than the number of playable cells. Re-rooting only ever moves the root
+    // further down the same line, so this bound holds across re-roots too.
+    int maxDepth = board->layout().cellCount() + 1;
+    maxMovesPerPly = board->maxMoveCount();
+    frames.resize(maxDepth);
+    moveBuffer.resize(maxDepth * maxMovesPerPly);
+}
+
+template <typename State>
+SolveResult BasicSolver<State>::solve(const StopToken *stopToken)
+{
+    PEGCORE_TRACE_SCOPE("solver", "solve");
+    stats = &Stats::local();
+    std::int64_t startNs = StopToken::nowNs();
+    bool wasSolved = solved;
+    if (Trace::Enabled && isSuspended() && frames[baseFrame].cursor > frames[baseFrame].moveBegin) {
+        // Resuming: the root move under the cursor is still being searched
+        traceRootMove(frames[baseFrame].cursor - 1 - frames[baseFrame].moveBegin);
+    }
+    Result result = search(stopToken);
+    if (Trace::Enabled) {
+        traceRootMove(-1);
+    }
+    searchElapsedNs += StopToken::nowNs() - startNs;
+    if (result == Result::Solved && !wasSolved) {
+        stats->recordSolution(searchElapsedNs);
+    }
+    return result;
+}
+
+template <typename State>
+SolveResult BasicSolver<State>::search(const StopToken *stopToken)
+{
+    if (!board) {
+        return Result::Unsolvable;
+    }
+    if (solved) {
+        return Result::Solved;
+    }
+
+    if (frameCount == baseFrame) {
+        // Fresh search: check the root position
+        searchElapsedNs = 0;
+        if (board->isWin()) {
+            solved = true;
+            return Result::Solved;
+        }
+
+        State rootId = board->canonicalId();
+        stats->add(Counter::TableProbes);
+        if (table.isKnownFailure(rootId)) {
+            stats->add(Counter::TableHits);
+            return Result::Unsolvable;
+        }
+        pushFrame(rootId);
+        orderRootMoves(*board);
+    }
+
+    while (frameCount > baseFrame) {
+        // Poll the token only every CheckInterval nodes; the poll itself is a
+        // single atomic load, which bounds both overhead and stop latency
+        nodesSearched++;
+        if ((nodesSearched & (StopToken::CheckInterval - 1)) == 0) {
+            if (stopToken && stopToken->stopRequested()) {
+                // Leave the stack and board as they are so the search can resume
+                return Result::Interrupted;
+            }
+            if (progressCallback && StopToken::nowNs() >= nextProgressNs) {
+                progressCallback(progress());
+                nextProgressNs = lastProgressNs + progressIntervalNs;
+            }
+        }
+
+        SearchFrame &frame = frames[frameCount - 1];
+
+        if (frame.cursor == frame.moveEnd) {
+            // Every move from this position failed - flag it and backtrack
+            table.markFailure(frame.stateId);
+            stats->add(Counter::Refuted);
+            stats->add(Counter::TableInserts);
+            frameCount--;
+            if (frameCount == baseFrame) {
+                return Result::Unsolvable;
+            }
+            board->undo();
+            appliedMoves--;
+            continue;
+        }
+
+        if (Trace::Enabled && frameCount - 1 == baseFrame) {
+            traceRootMove(frame.cursor - frame.moveBegin);
+        }
+        const Move &move = moveBuffer[frame.cursor++];
+        if (!board->play(move)) {
+            continue;
+        }
+        appliedMoves++;
+
+        if (board->isWin()) {
+            solved = true;
+            recordSolution();
+            return Result::Solved;
+        }
+        if (board->isGameOver()) {
+            // Dead end; cheaper to recognise again than to record in the table
+            stats->add(Counter::PrunedDeadEnd);
+            board->undo();
+            appliedMoves--;
+            continue;
+        }
+
+        State childId = board->canonicalId();
+        stats->add(Counter::TableProbes);
+        if (table.isKnownFailure(childId)) {
+            stats->add(Counter::TableHits);
+            stats->add(Counter::PrunedKnownFailure);
+            board->undo();
+            appliedMoves--;
+            continue;
+        }
+
+        pushFrame(childId);
+    }
+
+    return Result::Unsolvable;
+}
+
+template <typename State>
+bool BasicSolver<State>::reroot(const State &stateBits)
+{
+    for (int i = baseFrame; i < frameCount; ++i) {
+        if (frames[i].stateBits == stateBits) {
+            // Drop the frames above the new root; the board is untouched
+            // because it sits at the top of the stack, below the new root
+            appliedMoves -= i - baseFrame;
+            baseFrame = i;
+
+            // The frame's moves were left in generation order when it was
+            // pushed; rank the untried ones so bestCandidateMove() holds.
+            // Scoring needs the root position, which the board only shows
+            // when the new root is the top frame.
+            if (i == frameCount - 1) {
+                orderRootMoves(*board);
+            } else {
+                BasicBoard<State> rootBoard(board->layout(), board->rules(), stateBits);
+                orderRootMoves(rootBoard);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename State>
+bool BasicSolver<State>::isSuspended() const
+{
+    return frameCount > baseFrame && !solved;
+}
+
+template <typename State>
+std::vector<Move> BasicSolver<State>::solutionLine() const
+{
+    std::vector<Move> line;
+    if (!solved) {
+        return line;
+    }
+
+    // The move last taken from every frame leads to the winning state
+    line.reserve(frameCount - baseFrame);
+    for (int i = baseFrame; i < frameCount; ++i) {
+        line.push_back(moveBuffer[frames[i].cursor - 1]);
+    }
+    return line;
+}
+
+template <typename State>
+bool BasicSolver<State>::bestCandidateMove(Move &move) const
+{
+    if (frameCount == baseFrame) {
+        return false;
+    }
+
+    // Solved: the move taken from the root starts the winning line.
+    // Otherwise: the root move under the cursor, or the first before any is tried.
+    const SearchFrame &root = frames[baseFrame];
+    if (root.cursor > root.moveBegin) {
+        move = moveBuffer[root.cursor - 1];
+        return true;
+    }
+    if (root.moveEnd > root.moveBegin) {
+        move = moveBuffer[root.moveBegin];
+        return true;
+    }
+    return false;
+}
+
+template <typename State>
+int BasicSolver<State>::scoreMove(BasicBoard<State> &board, const Move &move)
+{
+    if (!board.play(move)) {
+        return std::numeric_limits<int>::min();
+    }
+
+    // Mobility after the move, less a penalty for every piece left stranded
+    // with no orthogonal neighbour to jump with or over. In anti-peg mode the
+    // roles of pegs and holes are swapped.
+    const Layout &layout = board.layout();
+    State pieces = board.rules() == Rules::AntiPeg ? ~board.pegs() & layout.allCells<State>() : board.pegs();
+    int stranded = 0;
+    for (int cell = 0; cell < layout.cellCount(); ++cell) {
+        if (testBit(pieces, cell) && isEmpty(pieces & layout.neighbours<State>(cell))) {
+            stranded++;
+        }
+    }
+    int mobility = board.mobility();
+
+    board.undo();
+    return mobility - 4 * stranded;
+}
+
+template <typename State>
+void BasicSolver<State>::setProgressCallback(std::function<void(const SolverProgress &)> callback, int intervalMsecs)
+{
+    progressCallback = std::move(callback);
+    progressIntervalNs = std::int64_t(intervalMsecs) * 1000000;
+    nextProgressNs = StopToken::nowNs() + progressIntervalNs;
+}
+
+template <typename State>
+SolverProgress BasicSolver<State>::progress()
+{
+    std::int64_t now = StopToken::nowNs();
+    std::uint64_t probes = table.getProbeCount();
+    std::uint64_t hits = table.getHitCount();
+
+    SolverProgress snapshot;
+    snapshot.nodesSearched = nodesSearched;
+    snapshot.nodesPerSecond = now > lastProgressNs
+        ? (nodesSearched - lastProgressNodes) * 1e9 / (now - lastProgressNs)
+        : 0.0;
+    snapshot.tableSize = table.size();
+    // The table may have been cleared since the last snapshot
+    snapshot.tableHitRate = probes > lastProgressProbes && hits >= lastProgressHits
+        ? double(hits - lastProgressHits) / (probes - lastProgressProbes)
+        : 0.0;
+    snapshot.depth = depth();
+    snapshot.rootMovesResolved = 0;
+    snapshot.rootMovesTotal = 0;
+    if (frameCount > baseFrame) {
+        // The move under the cursor is still being searched
+        const SearchFrame &root = frames[baseFrame];
+        snapshot.rootMovesTotal = root.moveEnd - root.moveBegin;
+        snapshot.rootMovesResolved = std::max(0, root.cursor - root.moveBegin - (frameCount > baseFrame + 1 ? 1 : 0));
+    }
+
+    lastProgressNs = now;
+    lastProgressNodes = nodesSearched;
+    lastProgressProbes = probes;
+    lastProgressHits = hits;
+    return snapshot;
+}
+
+template <typename State>
+int BasicSolver<State>::depth() const
+{
+    return frameCount - baseFrame;
+}
+
+template <typename State>
+std::uint64_t BasicSolver<State>::getNodesSearched() const
+{
+    return nodesSearched;
+}
+
+template <typename State>
+void BasicSolver<State>::reset()
+{
+    while (appliedMoves > 0) {
+        board->undo();
+        appliedMoves--;
+    }
+    baseFrame = 0;
+    frameCount = 0;
+    solved = false;
+}
+
+template <typename State>
+void BasicSolver<State>::traceRootMove(int rootMove)
+{
+    std::int64_t now = Trace::nowNs();
+    if (tracedRootMove >= 0) {
+        Trace::record("solver", "root move", tracedRootMoveStartNs, now, "move", tracedRootMove);
+    }
+    tracedRootMove = rootMove;
+    tracedRootMoveStartNs = now;
+}
+
+template <typename State>
+void BasicSolver<State>::pushFrame(const State &stateId)
+{
+    SearchFrame &frame = frames[frameCount];
+    frame.stateId = stateId;
+    frame.stateBits = board->pegs();
+    frame.moveBegin = frameCount * maxMovesPerPly;
+    frame.moveEnd = frame.moveBegin + board->generateMoves(moveBuffer.data() + frame.moveBegin);
+    frame.cursor = frame.moveBegin;
+    stats->recordExpansion(frameCount - baseFrame, frame.moveEnd - frame.moveBegin);
+    frameCount++;
+}
+
+template <typename State>
+void BasicSolver<State>::orderRootMoves(BasicBoard<State> &rootBoard)
+{
+    PEGCORE_TRACE_SCOPE("solver", "order root moves");
+    SearchFrame &root = frames[baseFrame];
+    Move *moves = moveBuffer.data() + root.cursor;
+    int count = root.moveEnd - root.cursor;
+
+    std::vector<int> scores(count);
+    for (int i = 0; i < count; ++i) {
+        scores[i] = scoreMove(rootBoard, moves[i]);
+    }
+
+    // Insertion sort, stable so equally scored moves keep generation order
+    for (int i = 1; i < count; ++i) {
+        Move move = moves[i];
+        int score = scores[i];
+        int j = i - 1;
+        while (j >= 0 && scores[j] < score) {
+            moves[j + 1] = moves[j];
+            scores[j + 1] = scores[j];
+            j--;
+        }
+        moves[j + 1] = move;
+        scores[j + 1] = score;
+    }
+}
+
+template <typename State>
+void BasicSolver<State>::recordSolution()
+{
+    PEGCORE_TRACE_SCOPE("cache", "record solution");
+    for (int i = baseFrame; i < frameCount; ++i) {
+        table.markWin(frames[i].stateId);
+    }
+    stats->add(Counter::TableInserts, frameCount - baseFrame);
+}
+
+template class BasicSolver<std::uint64_t>;
+template class BasicSolver<BitState<2>>;
+template class BasicSolver<BitState<4>>;
+
+} // namespace pegcore
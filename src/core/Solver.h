@@ -0,0 +1,241 @@
+#ifndef PEGCORE_SOLVER_H
+#define PEGCORE_SOLVER_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "core/Board.h"
+#include "core/Stats.h"
+#include "core/StopToken.h"
+#include "core/TranspositionTable.h"
+
+namespace pegcore {
+
+/**
+ * @brief Snapshot of a running search, reported periodically by Solver
+ */
+struct SolverProgress
+{
+    std::uint64_t nodesSearched; // Nodes expanded since the solver was created
+    double nodesPerSecond;       // Throughput since the previous report
+    int tableSize;               // States recorded in the transposition table
+    double tableHitRate;         // Share of table lookups that hit since the previous report
+    int depth;                   // Current depth below the root
+    int rootMovesResolved;       // Root moves already refuted
+    int rootMovesTotal;          // Root moves in total
+};
+
+/**
+ * @brief Outcome of BasicSolver::solve(), shared by every state width
+ */
+enum class SolveResult
+{
+    Solved,      // A winning line was found (see solutionLine())
+    Unsolvable,  // The root position cannot be won
+    Interrupted  // The stop callback fired; call solve() again to resume
+};
+
+/**
+ * @brief Iterative depth-first solver running on an explicit frame stack
+ *
+ * Instead of recursing once per ply, the solver keeps one fixed-size frame per
+ * ply holding the canonical state id and a cursor into a preallocated move
+ * buffer. Memory use is therefore bounded by the board size, and a search that
+ * is interrupted keeps its stack so it can be resumed later from the same node.
+ *
+ * Because the whole path from the root is kept, the search can also be
+ * re-rooted onto any position on that path (typically the position after the
+ * move the player just made): the frames above it are dropped and the work
+ * already spent below it carries over.
+ *
+ * The root moves are tried best-first by a heuristic score, and re-rooting
+ * ranks the new root's untried moves the same way, so when a search runs out of time the root move it is currently exploring is
+ * the most promising one not yet refuted (see bestCandidateMove()). Deeper
+ * plies keep generation order, which measured fastest for full solves.
+ *
+ * The solver is a template on the board's state type like BasicBoard; Solver
+ * searches the standard boards.
+ */
+template <typename State>
+class BasicSolver
+{
+public:
+    using Result = SolveResult;
+
+    /**
+     * @brief Create a solver searching on the given board
+     * @param board Board to search on; moves are applied to it in place
+     * @param table Shared table of positions already proven won or lost
+     */
+    BasicSolver(BasicBoard<State> *board, BasicTranspositionTable<State> &table);
+
+    /**
+     * @brief Start a new search or resume a suspended one
+     * @param stopToken Polled every StopToken::CheckInterval nodes; when it fires
+     *                  the search is suspended. May be null.
+     * @return Outcome of the search
+     */
+    Result solve(const StopToken *stopToken);
+
+    /**
+     * @brief Move the root of the search onto a position on the current path
+     * @param stateBits Exact state bits (Board::pegs()) of the new root
+     * @return True if the position was found and the search state was kept,
+     *         false if the caller has to reset() and start over
+     */
+    bool reroot(const State &stateBits);
+
+    /**
+     * @brief Check if a search was interrupted and can be resumed
+     * @return True if the frame stack holds a suspended search
+     */
+    bool isSuspended() const;
+
+    /**
+     * @brief Get the winning line found by the last successful solve()
+     * @return Moves from the root to the winning state, empty if not solved
+     */
+    std::vector<Move> solutionLine() const;
+
+    /**
+     * @brief Get the most promising root move found so far
+     *
+     * The first move of the winning line once solved; otherwise the root move
+     * currently being explored, since every root move tried before it has been
+     * refuted and the rest rank lower on the heuristic.
+     *
+     * @param move Set to the best candidate move
+     * @return False if the search has not started or the root has no move
+     */
+    bool bestCandidateMove(Move &move) const;
+
+    /**
+     * @brief Score a move for best-first ordering; higher is more promising
+     *
+     * Plays the move and rewards the mobility left while penalising stranded
+     * pieces. Too slow for every node, meant for root moves only.
+     *
+     * @param board Board the move is played on; restored before returning
+     * @param move The move to score
+     * @return Heuristic score of the move
+     */
+    static int scoreMove(BasicBoard<State> &board, const Move &move);
+
+    /**
+     * @brief Have the search report its progress while it runs
+     *
+     * Checked together with the stop token, so reports cost nothing between
+     * polls and arrive at most every intervalMsecs.
+     *
+     * @param callback Called from the searching thread, or null to disable
+     * @param intervalMsecs Minimum time between reports in milliseconds
+     */
+    void setProgressCallback(std::function<void(const SolverProgress &)> callback, int intervalMsecs);
+
+    /**
+     * @brief Take a progress snapshot of the search
+     * @return Current progress; throughput and hit rate cover the time since
+     *         the previous snapshot
+     */
+    SolverProgress progress();
+
+    /**
+     * @brief Get the number of frames currently on the stack
+     * @return Current search depth below the root
+     */
+    int depth() const;
+
+    /**
+     * @brief Get the number of nodes expanded since the solver was created
+     * @return Node count
+     */
+    std::uint64_t getNodesSearched() const;
+
+    /**
+     * @brief Discard the search state and restore the board to the root position
+     */
+    void reset();
+
+private:
+    struct SearchFrame
+    {
+        State stateId;   // Canonical id of the position at this ply
+        State stateBits; // Exact position at this ply, used for re-rooting
+        int moveBegin;           // First move of this ply in moveBuffer
+        int moveEnd;             // One past the last move of this ply
+        int cursor;              // Next move to try
+    };
+
+    BasicBoard<State> *board;
+    BasicTranspositionTable<State> &table;
+
+    std::vector<SearchFrame> frames; // Preallocated, one frame per possible ply
+    std::vector<Move> moveBuffer;    // Preallocated, maxMovesPerPly moves per frame
+    int baseFrame;                   // Frame of the current root
+    int frameCount;                  // One past the top frame
+    int appliedMoves;                // Moves applied to the board since the root
+    int maxMovesPerPly;
+    bool solved;
+    std::uint64_t nodesSearched;
+    StatsShard *stats;             // Shard of the thread running solve()
+    std::int64_t searchElapsedNs;  // Time spent in solve() since the search started
+
+    // Progress reporting
+    std::function<void(const SolverProgress &)> progressCallback;
+    std::int64_t progressIntervalNs;
+    std::int64_t nextProgressNs;
+    std::int64_t lastProgressNs;
+    std::uint64_t lastProgressNodes;
+    std::uint64_t lastProgressProbes;
+    std::uint64_t lastProgressHits;
+
+    // Root move being traced (see traceRootMove()), -1 for none
+    int tracedRootMove;
+    std::int64_t tracedRootMoveStartNs;
+
+    /**
+     * @brief Run the search loop of solve()
+     * @param stopToken See solve()
+     * @return Outcome of the search
+     */
+    Result search(const StopToken *stopToken);
+
+    /**
+     * @brief End the span of the root move being traced and start the next
+     * @param rootMove Offset of the next root move in best-first order, or -1
+     *                 to only end the current span
+     */
+    void traceRootMove(int rootMove);
+
+    /**
+     * @brief Push a frame for the board's current position and generate its moves
+     * @param stateId Canonical id of the current position
+     */
+    void pushFrame(const State &stateId);
+
+    /**
+     * @brief Sort the root frame's untried moves by scoreMove(), best first
+     *
+     * Moves before the cursor are refuted or still being searched and keep
+     * their place.
+     *
+     * @param rootBoard Board showing the root position; restored before returning
+     */
+    void orderRootMoves(BasicBoard<State> &rootBoard);
+
+    /**
+     * @brief Record every position on the winning line in the table
+     */
+    void recordSolution();
+};
+
+// Solver of the standard boards
+using Solver = BasicSolver<std::uint64_t>;
+
+extern template class BasicSolver<std::uint64_t>;
+extern template class BasicSolver<BitState<2>>;
+extern template class BasicSolver<BitState<4>>;
+
+} // namespace pegcore
+
+#endif // PEGCORE_SOLVER_H
@@ -0,0 +1,192 @@
+#include "core/Stats.h"
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace pegcore {
+
+namespace {
+
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<StatsShard>> shards;
+};
+
+Registry &registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+const char *counterName(Counter counter)
+{
+    switch (counter) {
+        case Counter::NodesExpanded: return "Nodes expanded";
+        case Counter::MovesGenerated: return "Moves generated";
+        case Counter::TableProbes: return "Table probes";
+        case Counter::TableHits: return "Table hits";
+        case Counter::TableInserts: return "Table inserts";
+        case Counter::PrunedDeadEnd: return "Pruned: dead end";
+        case Counter::PrunedKnownFailure: return "Pruned: known loss";
+        case Counter::Refuted: return "Refuted";
+        case Counter::Solutions: return "Solutions";
+        case Counter::Count: break;
+    }
+    return "";
+}
+
+// Append printf-style output to a string
+template <typename... Args>
+void appendFormat(std::string &text, const char *format, Args... args)
+{
+    char line[160];
+    std::snprintf(line, sizeof(line), format, args...);
+    text += line;
+}
+
+} // namespace
+
+double SolverStats::averageBranching(int ply) const
+{
+    std::uint64_t positions = 0;
+    std::uint64_t moves = 0;
+    for (int bucket = 0; bucket < BranchingBuckets; ++bucket) {
+        positions += branching[ply][bucket];
+        moves += branching[ply][bucket] * bucket;
+    }
+    return positions > 0 ? double(moves) / positions : 0.0;
+}
+
+std::string SolverStats::toText(bool perPly) const
+{
+    std::string text;
+    for (int i = 0; i < int(Counter::Count); ++i) {
+        appendFormat(text, "%-20s %llu\n", counterName(Counter(i)), (unsigned long long)counters[i]);
+    }
+
+    std::uint64_t probes = value(Counter::TableProbes);
+    std::uint64_t nodes = value(Counter::NodesExpanded);
+    appendFormat(text, "%-20s %.1f%%\n", "Table hit rate", probes > 0 ? 100.0 * value(Counter::TableHits) / probes : 0.0);
+    appendFormat(text, "%-20s %.2f\n", "Average branching",
+                 nodes > 0 ? double(value(Counter::MovesGenerated)) / nodes : 0.0);
+    appendFormat(text, "%-20s %d\n", "Max depth", maxDepth);
+
+    std::uint64_t solutions = value(Counter::Solutions);
+    if (solutions > 0) {
+        appendFormat(text, "%-20s avg %.3f ms, min %.3f ms, max %.3f ms\n", "First solution",
+                     firstSolutionTotalNs / 1e6 / solutions, firstSolutionMinNs / 1e6, firstSolutionMaxNs / 1e6);
+        for (int bucket = 0; bucket < TimeBuckets; ++bucket) {
+            if (firstSolution[bucket] > 0) {
+                appendFormat(text, "  from %10llu us: %llu\n", bucket == 0 ? 0ULL : 1ULL << bucket,
+                             (unsigned long long)firstSolution[bucket]);
+            }
+        }
+    }
+
+    if (!perPly) {
+        return text;
+    }
+
+    // Only the plies that were reached
+    text += "Branching by ply (positions, average moves, max moves):\n";
+    for (int ply = 0; ply < MaxPly; ++ply) {
+        std::uint64_t positions = 0;
+        int maxMoves = 0;
+        for (int bucket = 0; bucket < BranchingBuckets; ++bucket) {
+            positions += branching[ply][bucket];
+            if (branching[ply][bucket] > 0) {
+                maxMoves = bucket;
+            }
+        }
+        if (positions > 0) {
+            appendFormat(text, "  %2d: %12llu  %5.2f  %s%d\n", ply, (unsigned long long)positions,
+                         averageBranching(ply), maxMoves == BranchingBuckets - 1 ? ">=" : "", maxMoves);
+        }
+    }
+    return text;
+}
+
+StatsShard::StatsShard()
+    : maxDepth(0),
+      firstSolutionTotalNs(0),
+      firstSolutionMinNs(std::numeric_limits<std::uint64_t>::max()),
+      firstSolutionMaxNs(0)
+{
+    for (auto &counter : counters) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+    for (auto &ply : branching) {
+        for (auto &bucket : ply) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+    for (auto &bucket : firstSolution) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+void StatsShard::recordSolution(std::int64_t searchNs)
+{
+    std::uint64_t ns = searchNs > 0 ? std::uint64_t(searchNs) : 0;
+    bump(counters[int(Counter::Solutions)], 1);
+    bump(firstSolutionTotalNs, ns);
+    if (ns < firstSolutionMinNs.load(std::memory_order_relaxed)) {
+        firstSolutionMinNs.store(ns, std::memory_order_relaxed);
+    }
+    if (ns > firstSolutionMaxNs.load(std::memory_order_relaxed)) {
+        firstSolutionMaxNs.store(ns, std::memory_order_relaxed);
+    }
+
+    int bucket = 0;
+    for (std::uint64_t micros = ns / 1000; micros > 1 && bucket < SolverStats::TimeBuckets - 1; micros >>= 1) {
+        bucket++;
+    }
+    bump(firstSolution[bucket], 1);
+}
+
+StatsShard &Stats::local()
+{
+    thread_local StatsShard *shard = nullptr;
+    if (!shard) {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.shards.push_back(std::make_unique<StatsShard>());
+        shard = reg.shards.back().get();
+    }
+    return *shard;
+}
+
+SolverStats Stats::snapshot()
+{
+    SolverStats stats{};
+    stats.firstSolutionMinNs = std::numeric_limits<std::uint64_t>::max();
+
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const std::unique_ptr<StatsShard> &shard : reg.shards) {
+        for (int i = 0; i < int(Counter::Count); ++i) {
+            stats.counters[i] += shard->counters[i].load(std::memory_order_relaxed);
+        }
+        stats.maxDepth = std::max(stats.maxDepth, shard->maxDepth.load(std::memory_order_relaxed));
+        for (int ply = 0; ply < SolverStats::MaxPly; ++ply) {
+            for (int bucket = 0; bucket < SolverStats::BranchingBuckets; ++bucket) {
+                stats.branching[ply][bucket] += shard->branching[ply][bucket].load(std::memory_order_relaxed);
+            }
+        }
+        stats.firstSolutionTotalNs += shard->firstSolutionTotalNs.load(std::memory_order_relaxed);
+        stats.firstSolutionMinNs = std::min(stats.firstSolutionMinNs,
+                                            shard->firstSolutionMinNs.load(std::memory_order_relaxed));
+        stats.firstSolutionMaxNs = std::max(stats.firstSolutionMaxNs,
+                                            shard->firstSolutionMaxNs.load(std::memory_order_relaxed));
+        for (int bucket = 0; bucket < SolverStats::TimeBuckets; ++bucket) {
+            stats.firstSolution[bucket] += shard->firstSolution[bucket].load(std::memory_order_relaxed);
+        }
+    }
+    return stats;
+}
+
+} // namespace pegcore
@@ -0,0 +1,149 @@
+#ifndef PEGCORE_STATS_H
+#define PEGCORE_STATS_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "core/Layout.h"
+
+namespace pegcore {
+
+/**
+ * @brief Counters kept by the search
+ */
+enum class Counter
+{
+    NodesExpanded,      // Positions whose moves were generated
+    MovesGenerated,     // Moves generated over all expanded positions
+    TableProbes,        // Lookups of proven-lost positions
+    TableHits,          // Lookups that found the position
+    TableInserts,       // Positions recorded as won or lost
+    PrunedDeadEnd,      // Children skipped because no move is left
+    PrunedKnownFailure, // Children skipped because the table proves them lost
+    Refuted,            // Positions proven lost by trying every move
+    Solutions,          // Searches that found a winning line
+    Count
+};
+
+/**
+ * @brief Merged statistics of every thread, as returned by Stats::snapshot()
+ */
+struct SolverStats
+{
+    // Histograms are kept per ply below the search root; deeper plies are
+    // impossible since every move changes the peg count by one
+    static constexpr int MaxPly = Layout::MaxCells + 1;
+    // Branching factors of this and above share the last bucket
+    static constexpr int BranchingBuckets = 32;
+    // Bucket i counts times in [2^i, 2^(i+1)) microseconds
+    static constexpr int TimeBuckets = 32;
+
+    std::uint64_t counters[int(Counter::Count)];
+    int maxDepth;
+    std::uint64_t branching[MaxPly][BranchingBuckets]; // Positions by ply and number of moves
+    std::uint64_t firstSolutionTotalNs;                // Search time until each winning line was found
+    std::uint64_t firstSolutionMinNs;
+    std::uint64_t firstSolutionMaxNs;
+    std::uint64_t firstSolution[TimeBuckets];
+
+    std::uint64_t value(Counter counter) const { return counters[int(counter)]; }
+
+    /**
+     * @brief Get the average number of moves of the positions expanded at a ply
+     * @param ply Depth below the search root
+     * @return Average branching factor, 0 if no position was expanded there
+     */
+    double averageBranching(int ply) const;
+
+    /**
+     * @brief Format the statistics as a human-readable report
+     * @param perPly Append a table of the branching factors of every ply reached
+     * @return Report with one line per counter and derived figure
+     */
+    std::string toText(bool perPly = true) const;
+};
+
+/**
+ * @brief One thread's statistics, updated without synchronisation
+ *
+ * Only the owning thread writes, so every update is a plain load and store
+ * of a relaxed atomic: as cheap as a non-atomic increment, yet readable from
+ * the thread taking a snapshot.
+ */
+class StatsShard
+{
+public:
+    StatsShard();
+
+    void add(Counter counter, std::uint64_t amount = 1)
+    {
+        bump(counters[int(counter)], amount);
+    }
+
+    /**
+     * @brief Record an expanded position
+     * @param ply Depth below the search root
+     * @param moves Number of moves generated for it
+     */
+    void recordExpansion(int ply, int moves)
+    {
+        bump(counters[int(Counter::NodesExpanded)], 1);
+        bump(counters[int(Counter::MovesGenerated)], moves);
+        if (ply >= SolverStats::MaxPly) {
+            ply = SolverStats::MaxPly - 1;
+        }
+        bump(branching[ply][moves < SolverStats::BranchingBuckets ? moves : SolverStats::BranchingBuckets - 1], 1);
+        if (ply > maxDepth.load(std::memory_order_relaxed)) {
+            maxDepth.store(ply, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Record a search that found a winning line
+     * @param searchNs Search time from the start of the search to the win
+     */
+    void recordSolution(std::int64_t searchNs);
+
+private:
+    friend class Stats;
+
+    std::atomic<std::uint64_t> counters[int(Counter::Count)];
+    std::atomic<int> maxDepth;
+    std::atomic<std::uint64_t> branching[SolverStats::MaxPly][SolverStats::BranchingBuckets];
+    std::atomic<std::uint64_t> firstSolutionTotalNs;
+    std::atomic<std::uint64_t> firstSolutionMinNs;
+    std::atomic<std::uint64_t> firstSolutionMaxNs;
+    std::atomic<std::uint64_t> firstSolution[SolverStats::TimeBuckets];
+
+    static void bump(std::atomic<std::uint64_t> &value, std::uint64_t amount)
+    {
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief Registry of the per-thread statistics of the search
+ *
+ * Each searching thread updates its own shard, so the search never contends
+ * on a shared counter; snapshot() merges the shards of all threads that ever
+ * searched. The statistics cover the whole process lifetime.
+ */
+class Stats
+{
+public:
+    /**
+     * @brief Get the calling thread's shard, creating it on first use
+     * @return Shard owned by the registry; stays valid after the thread ends
+     */
+    static StatsShard &local();
+
+    /**
+     * @brief Merge the shards of every thread
+     * @return Statistics summed over all threads
+     */
+    static SolverStats snapshot();
+};
+
+} // namespace pegcore
+
+#endif // PEGCORE_STATS_H
@@ -0,0 +1,73 @@
+#include "core/StopToken.h"
+#include <chrono>
+
+namespace pegcore {
+
+StopToken::StopToken()
+    : stopReason(static_cast<int>(Reason::None)),
+      requestedAtNs(0),
+      deadlineNs(0)
+{
+}
+
+void StopToken::requestStop(Reason reason)
+{
+    int expected = static_cast<int>(Reason::None);
+    if (stopReason.compare_exchange_strong(expected, static_cast<int>(reason))) {
+        requestedAtNs.store(nowNs(), std::memory_order_relaxed);
+    }
+}
+
+void StopToken::reset()
+{
+    deadlineNs.store(0, std::memory_order_relaxed);
+    requestedAtNs.store(0, std::memory_order_relaxed);
+    stopReason.store(static_cast<int>(Reason::None));
+}
+
+void StopToken::setDeadline(std::int64_t msecs)
+{
+    deadlineNs.store(msecs > 0 ? nowNs() + msecs * 1000000 : 0, std::memory_order_relaxed);
+}
+
+bool StopToken::stopRequested() const
+{
+    if (stopReason.load(std::memory_order_relaxed) != static_cast<int>(Reason::None)) {
+        return true;
+    }
+
+    std::int64_t deadline = deadlineNs.load(std::memory_order_relaxed);
+    if (deadline != 0 && nowNs() >= deadline) {
+        // Latch the expired deadline as a regular stop so the reason and
+        // latency are reported like any other request
+        int expected = static_cast<int>(Reason::None);
+        if (stopReason.compare_exchange_strong(expected, static_cast<int>(Reason::Deadline))) {
+            requestedAtNs.store(deadline, std::memory_order_relaxed);
+        }
+        return true;
+    }
+    return false;
+}
+
+StopToken::Reason StopToken::reason() const
+{
+    return static_cast<Reason>(stopReason.load());
+}
+
+std::int64_t StopToken::stopLatencyNs() const
+{
+    if (reason() == Reason::None) {
+        return -1;
+    }
+
+    // A deadline stop dates from the deadline itself, not from when it was noticed
+    return nowNs() - requestedAtNs.load(std::memory_order_relaxed);
+}
+
+std::int64_t StopToken::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace pegcore
@@ -0,0 +1,83 @@
+#ifndef PEGCORE_STOPTOKEN_H
+#define PEGCORE_STOPTOKEN_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace pegcore {
+
+/**
+ * @brief Lock-free cooperative cancellation flag for long-running searches
+ *
+ * The search polls the token every CheckInterval nodes. Polling costs one
+ * relaxed atomic load, plus a clock read when a deadline is set, so the
+ * search never takes a lock. The token remembers when a stop was first
+ * requested, which lets the search measure how long it took to notice it.
+ */
+class StopToken
+{
+public:
+    enum class Reason
+    {
+        None,
+        Cancelled,       // The request was withdrawn
+        PositionChanged, // The board moved on to a different position
+        Deadline         // The hard time limit expired
+    };
+
+    // Number of search nodes between two polls of the token
+    static constexpr int CheckInterval = 1024;
+
+    StopToken();
+
+    /**
+     * @brief Ask the search to stop; only the first reason is kept
+     * @param reason Why the search should stop
+     */
+    void requestStop(Reason reason);
+
+    /**
+     * @brief Clear any stop request and deadline before starting a new search
+     */
+    void reset();
+
+    /**
+     * @brief Make the token fire on its own after a time limit
+     * @param msecs Time limit from now in milliseconds, 0 to disable
+     */
+    void setDeadline(std::int64_t msecs);
+
+    /**
+     * @brief Check if the search should stop; cheap enough for the hot path
+     * @return True if a stop was requested or the deadline expired
+     */
+    bool stopRequested() const;
+
+    /**
+     * @brief Get the reason of the pending stop request
+     * @return Stop reason, or Reason::None if the search may continue
+     */
+    Reason reason() const;
+
+    /**
+     * @brief Time elapsed since the stop was requested or the deadline expired
+     * @return Latency in nanoseconds, or -1 if no stop is pending
+     */
+    std::int64_t stopLatencyNs() const;
+
+    /**
+     * @brief Current monotonic time used for deadlines and latencies
+     * @return Nanoseconds on the steady clock
+     */
+    static std::int64_t nowNs();
+
+private:
+    // Mutable so that stopRequested() can latch an expired deadline
+    mutable std::atomic<int> stopReason;
+    mutable std::atomic<std::int64_t> requestedAtNs;
+    std::atomic<std::int64_t> deadlineNs; // 0 when no deadline is set
+};
+
+} // namespace pegcore
+
+#endif // PEGCORE_STOPTOKEN_H
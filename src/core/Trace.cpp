@@ -0,0 +1,234 @@
+#include "core/Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace pegcore {
+
+namespace {
+
+struct TraceEvent
+{
+    const char *category;
+    const char *name;
+    const char *argName;
+    std::int64_t argValue;
+    std::int64_t startNs;
+    std::int64_t endNs;
+    std::uint64_t asyncId; // 0 for a span on the thread's own stack
+};
+
+/**
+ * @brief Ring buffer of one thread's events
+ *
+ * Only its thread writes to it; the lock is there for exports and clears
+ * from other threads, so it is uncontended while recording.
+ */
+struct ThreadBuffer
+{
+    std::mutex mutex;
+    int threadId;
+    std::string threadName;
+    std::vector<TraceEvent> events; // BufferCapacity slots once the first event arrives
+    std::uint64_t written = 0;      // Events recorded since the last clear
+};
+
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+Registry &registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+// Buffers are never freed, so one outlives its thread and its events can
+// still be exported; there are only a handful of threads
+ThreadBuffer &threadBuffer()
+{
+    thread_local ThreadBuffer *buffer = nullptr;
+    if (!buffer) {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.buffers.push_back(std::make_unique<ThreadBuffer>());
+        buffer = reg.buffers.back().get();
+        buffer->threadId = int(reg.buffers.size());
+    }
+    return *buffer;
+}
+
+void append(const TraceEvent &event)
+{
+    ThreadBuffer &buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    if (buffer.events.empty()) {
+        buffer.events.resize(Trace::BufferCapacity);
+    }
+    buffer.events[buffer.written % Trace::BufferCapacity] = event;
+    buffer.written++;
+}
+
+// Names are literals chosen by the code, but escape anyway so a stray quote
+// cannot break the file
+void writeString(std::ostream &out, const char *text)
+{
+    out << '"';
+    for (const char *c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\' << *c;
+        } else if (static_cast<unsigned char>(*c) >= 0x20) {
+            out << *c;
+        }
+    }
+    out << '"';
+}
+
+void writeMicros(std::ostream &out, std::int64_t ns)
+{
+    // Chrome timestamps are microseconds; keep nanosecond precision
+    out << ns / 1000 << '.';
+    std::int64_t fraction = ns % 1000;
+    out << char('0' + fraction / 100) << char('0' + fraction / 10 % 10) << char('0' + fraction % 10);
+}
+
+} // namespace
+
+std::int64_t Trace::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Trace::record(const char *category, const char *name, std::int64_t startNs, std::int64_t endNs,
+                   const char *argName, std::int64_t argValue)
+{
+    if (!Enabled) {
+        return;
+    }
+    append({category, name, argName, argValue, startNs, endNs, 0});
+}
+
+void Trace::recordAsync(const char *category, const char *name, std::uint64_t id,
+                        std::int64_t startNs, std::int64_t endNs)
+{
+    if (!Enabled) {
+        return;
+    }
+    // Id 0 marks thread spans, so shift ids up by one
+    append({category, name, nullptr, 0, startNs, endNs, id + 1});
+}
+
+void Trace::setThreadName(const std::string &name)
+{
+    if (!Enabled) {
+        return;
+    }
+    ThreadBuffer &buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.threadName = name;
+}
+
+void Trace::writeChromeJson(std::ostream &out)
+{
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> registryLock(reg.mutex);
+
+    // Collect first so the earliest event can serve as time zero
+    struct Collected
+    {
+        int threadId;
+        TraceEvent event;
+    };
+    std::vector<Collected> events;
+    std::vector<std::pair<int, std::string>> threadNames;
+    for (const std::unique_ptr<ThreadBuffer> &buffer : reg.buffers) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        if (!buffer->threadName.empty()) {
+            threadNames.emplace_back(buffer->threadId, buffer->threadName);
+        }
+        std::uint64_t count = std::min<std::uint64_t>(buffer->written, BufferCapacity);
+        for (std::uint64_t i = buffer->written - count; i < buffer->written; ++i) {
+            events.push_back({buffer->threadId, buffer->events[i % BufferCapacity]});
+        }
+    }
+    std::sort(events.begin(), events.end(), [](const Collected &a, const Collected &b) {
+        return a.event.startNs < b.event.startNs;
+    });
+    std::int64_t epochNs = events.empty() ? 0 : events.front().event.startNs;
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto separate = [&]() {
+        out << (first ? "\n" : ",\n");
+        first = false;
+    };
+    for (const auto &thread : threadNames) {
+        separate();
+        out << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.first << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+        writeString(out, thread.second.c_str());
+        out << "}}";
+    }
+    for (const Collected &item : events) {
+        const TraceEvent &event = item.event;
+        if (event.asyncId != 0) {
+            // Async spans are a begin and an end event sharing an id
+            for (int end = 0; end < 2; ++end) {
+                separate();
+                out << "{\"ph\":\"" << (end ? 'e' : 'b') << "\",\"pid\":1,\"tid\":" << item.threadId
+                    << ",\"id\":" << event.asyncId - 1 << ",\"cat\":";
+                writeString(out, event.category);
+                out << ",\"name\":";
+                writeString(out, event.name);
+                out << ",\"ts\":";
+                writeMicros(out, (end ? event.endNs : event.startNs) - epochNs);
+                out << '}';
+            }
+            continue;
+        }
+        separate();
+        out << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << item.threadId << ",\"cat\":";
+        writeString(out, event.category);
+        out << ",\"name\":";
+        writeString(out, event.name);
+        out << ",\"ts\":";
+        writeMicros(out, event.startNs - epochNs);
+        out << ",\"dur\":";
+        writeMicros(out, std::max<std::int64_t>(0, event.endNs - event.startNs));
+        if (event.argName) {
+            out << ",\"args\":{";
+            writeString(out, event.argName);
+            out << ':' << event.argValue << '}';
+        }
+        out << '}';
+    }
+    out << "\n]}\n";
+}
+
+bool Trace::writeChromeJson(const std::string &path)
+{
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    writeChromeJson(file);
+    file.close();
+    return !file.fail();
+}
+
+void Trace::clear()
+{
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> registryLock(reg.mutex);
+    for (const std::unique_ptr<ThreadBuffer> &buffer : reg.buffers) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        buffer->written = 0;
+    }
+}
+
+} // namespace pegcore
@@ -0,0 +1,137 @@
+#ifndef PEGCORE_TRACE_H
+#define PEGCORE_TRACE_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Set by the PEG_TRACE build option; without it spans compile to nothing
+#ifndef PEGCORE_TRACE
+#define PEGCORE_TRACE 0
+#endif
+
+namespace pegcore {
+
+/**
+ * @brief Low-overhead span tracing with Chrome trace export
+ *
+ * Every thread records into its own fixed-size ring buffer, so recording never
+ * allocates and only takes the buffer's own (uncontended) lock; once a buffer
+ * is full the oldest events are overwritten. The buffers can be exported at
+ * any time as Chrome trace JSON, which chrome://tracing and ui.perfetto.dev
+ * open directly.
+ *
+ * Tracing is a build option (PEG_TRACE). Without it Enabled is false, the
+ * PEGCORE_TRACE_SCOPE macro expands to nothing and record() does nothing, so
+ * release builds pay nothing for the instrumentation.
+ *
+ * Names and categories are not copied and must be string literals.
+ */
+class Trace
+{
+public:
+    static constexpr bool Enabled = PEGCORE_TRACE != 0;
+
+    // Events kept per thread before the oldest are overwritten
+    static constexpr int BufferCapacity = 8192;
+
+    /**
+     * @brief Get the trace clock
+     * @return Monotonic time in nanoseconds
+     */
+    static std::int64_t nowNs();
+
+    /**
+     * @brief Record a finished span on the calling thread
+     * @param category Category of the span, e.g. "solver"
+     * @param name Name of the span
+     * @param startNs Start time from nowNs()
+     * @param endNs End time from nowNs()
+     * @param argName Name of an integer argument shown with the span, or null
+     * @param argValue Value of the argument
+     */
+    static void record(const char *category, const char *name, std::int64_t startNs, std::int64_t endNs,
+                       const char *argName = nullptr, std::int64_t argValue = 0);
+
+    /**
+     * @brief Record a span that is not tied to one thread's call stack
+     *
+     * For operations that start and end in different places, such as a
+     * request answered by a signal from another thread. Spans with the same
+     * name and id form one track in the viewer.
+     *
+     * @param category Category of the span
+     * @param name Name of the span
+     * @param id Identifies the operation, e.g. a job id
+     * @param startNs Start time from nowNs()
+     * @param endNs End time from nowNs()
+     */
+    static void recordAsync(const char *category, const char *name, std::uint64_t id,
+                            std::int64_t startNs, std::int64_t endNs);
+
+    /**
+     * @brief Name the calling thread in exported traces
+     * @param name Thread name
+     */
+    static void setThreadName(const std::string &name);
+
+    /**
+     * @brief Write every buffered event as Chrome trace JSON
+     * @param out Stream to write to
+     */
+    static void writeChromeJson(std::ostream &out);
+
+    /**
+     * @brief Write every buffered event as Chrome trace JSON to a file
+     * @param path File to create or overwrite
+     * @return False if the file could not be written
+     */
+    static bool writeChromeJson(const std::string &path);
+
+    /**
+     * @brief Drop every buffered event; thread names are kept
+     */
+    static void clear();
+};
+
+/**
+ * @brief Records a span from its construction to the end of its scope
+ *
+ * Use through PEGCORE_TRACE_SCOPE so it disappears from untraced builds.
+ */
+class TraceSpan
+{
+public:
+    TraceSpan(const char *category, const char *name)
+        : category(category), name(name), startNs(Trace::nowNs())
+    {
+    }
+
+    ~TraceSpan()
+    {
+        Trace::record(category, name, startNs, Trace::nowNs());
+    }
+
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+    const char *category;
+    const char *name;
+    std::int64_t startNs;
+};
+
+} // namespace pegcore
+
+#define PEGCORE_TRACE_CONCAT_(a, b) a##b
+#define PEGCORE_TRACE_CONCAT(a, b) PEGCORE_TRACE_CONCAT_(a, b)
+
+#if PEGCORE_TRACE
+// Trace the rest of the enclosing scope as a span
+#define PEGCORE_TRACE_SCOPE(category, name) \
+    ::pegcore::TraceSpan PEGCORE_TRACE_CONCAT(pegcoreTraceSpan, __LINE__)(category, name)
+#else
+#define PEGCORE_TRACE_SCOPE(category, name) do {} while (false)
+#endif
+
+#endif // PEGCORE_TRACE_H
@@ -0,0 +1,76 @@
+#include "core/TranspositionTable.h"
+#include "core/Trace.h"
+
+namespace pegcore {
+
+template <typename StateId>
+bool BasicTranspositionTable<StateId>::isKnownFailure(const StateId &stateId)
+{
+    std::lock_guard<std::mutex> locker(mutex);
+    bool found = failedStates.count(stateId) != 0;
+    probes++;
+    hits += found;
+    return found;
+}
+
+template <typename StateId>
+void BasicTranspositionTable<StateId>::markFailure(const StateId &stateId)
+{
+    std::lock_guard<std::mutex> locker(mutex);
+    failedStates.insert(stateId);
+}
+
+template <typename StateId>
+bool BasicTranspositionTable<StateId>::isKnownWin(const StateId &stateId)
+{
+    std::lock_guard<std::mutex> locker(mutex);
+    bool found = winningStates.count(stateId) != 0;
+    probes++;
+    hits += found;
+    return found;
+}
+
+template <typename StateId>
+void BasicTranspositionTable<StateId>::markWin(const StateId &stateId)
+{
+    std::lock_guard<std::mutex> locker(mutex);
+    winningStates.insert(stateId);
+}
+
+template <typename StateId>
+int BasicTranspositionTable<StateId>::size()
+{
+    std::lock_guard<std::mutex> locker(mutex);
+    return int(failedStates.size() + winningStates.size());
+}
+
+template <typename StateId>
+std::uint64_t BasicTranspositionTable<StateId>::getProbeCount()
+{
+    std::lock_guard<std::mutex> locker(mutex);
+    return probes;
+}
+
+template <typename StateId>
+std::uint64_t BasicTranspositionTable<StateId>::getHitCount()
+{
+    std::lock_guard<std::mutex> locker(mutex);
+    return hits;
+}
+
+template <typename StateId>
+void BasicTranspositionTable<StateId>::clear()
+{
+    PEGCORE_TRACE_SCOPE("cache", "table clear");
+    std::lock_guard<std::mutex> locker(mutex);
+    failedStates.clear();
+    winningStates.clear();
+    probes = 0;
+    hits = 0;
+}
+
+template class BasicTranspositionTable<std::uint64_t>;
+template class BasicTranspositionTable<BitState<2>>;
+template class BasicTranspositionTable<BitState<4>>;
+
+} // namespace pegcore
@@ -0,0 +1,93 @@
+#ifndef PEGCORE_TRANSPOSITIONTABLE_H
+#define PEGCORE_TRANSPOSITIONTABLE_H
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_set>
+#include "core/BitState.h"
+
+namespace pegcore {
+
+/**
+ * @brief Thread-safe table of solved positions keyed by canonical board state id
+ *
+ * Positions proven unsolvable and positions proven winnable are recorded
+ * separately so that any search - a hint request, a resumed search or a later
+ * request from a different position - can reuse results found earlier.
+ *
+ * Keyed by the state type of the boards searched with it (see BasicBoard);
+ * TranspositionTable serves the standard boards.
+ */
+template <typename StateId>
+class BasicTranspositionTable
+{
+public:
+    BasicTranspositionTable() = default;
+
+    /**
+     * @brief Check if a state is known to be unsolvable
+     * @param stateId Canonical board state id
+     * @return True if the state was flagged as failed
+     */
+    bool isKnownFailure(const StateId &stateId);
+
+    /**
+     * @brief Flag a state as unsolvable
+     * @param stateId Canonical board state id
+     */
+    void markFailure(const StateId &stateId);
+
+    /**
+     * @brief Check if a state is known to lead to a win
+     * @param stateId Canonical board state id
+     * @return True if the state was proven winnable
+     */
+    bool isKnownWin(const StateId &stateId);
+
+    /**
+     * @brief Flag a state as winnable
+     * @param stateId Canonical board state id
+     */
+    void markWin(const StateId &stateId);
+
+    /**
+     * @brief Get the total number of recorded states
+     * @return Number of failed plus winnable states
+     */
+    int size();
+
+    /**
+     * @brief Get the number of lookups made since the table was last cleared
+     * @return Number of isKnownFailure() and isKnownWin() calls
+     */
+    std::uint64_t getProbeCount();
+
+    /**
+     * @brief Get the number of lookups that found their state
+     * @return Number of lookups that returned true
+     */
+    std::uint64_t getHitCount();
+
+    /**
+     * @brief Forget all recorded states
+     */
+    void clear();
+
+private:
+    std::mutex mutex;
+    std::unordered_set<StateId, StateHash<StateId>> failedStates;
+    std::unordered_set<StateId, StateHash<StateId>> winningStates;
+    std::uint64_t probes = 0;
+    std::uint64_t hits = 0;
+};
+
+// Table of the standard boards' state ids
+using TranspositionTable = BasicTranspositionTable<std::uint64_t>;
+
+extern template class BasicTranspositionTable<std::uint64_t>;
+extern template class BasicTranspositionTable<BitState<2>>;
+extern template class BasicTranspositionTable<BitState<4>>;
+
+} // namespace pegcore
+
+#endif // PEGCORE_TRANSPOSITIONTABLE_H
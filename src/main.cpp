@@ -1,4 +1,5 @@
 #include "mainwindow.h"
+#include "core/Trace.h"
 
 #include <QApplication>
 #include <QIcon>
@@ -6,6 +7,7 @@
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
+    pegcore::Trace::setThreadName("GUI");
     
     // Set application properties
     a.setApplicationName("Peg Solitaire");
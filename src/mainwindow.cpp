@@ -1,8 +1,14 @@
 #include "mainwindow.h"
 #include <QStackedWidget>
-#include <QDebug>                   // For logging
+#include "utils/Logging.h"         // For logging
 #include <QIcon>                    // For window icon
 #include "models/Board.h"           // For creating board instances
+#include "core/Trace.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QShortcut>
+#include <QStandardPaths>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent),
@@ -13,13 +19,15 @@ MainWindow::MainWindow(QWidget *parent)
       settingsPageView(new SettingsPageView(this)),
       settingsPageController(new SettingsPageController(settingsPageView, this)),
       gameView(new GameView(this)), // Changed from BoardView to GameView
-      currentBoardModel(nullptr) // Initialize currentBoardModel
+      currentBoardModel(nullptr), // Initialize currentBoardModel
+      endgamePool(new EndgamePool(this))
 {
     stackedWidget = new QStackedWidget(this);
     stackedWidget->addWidget(homePageView);
     stackedWidget->addWidget(startPageView);
     stackedWidget->addWidget(settingsPageView);
     stackedWidget->addWidget(gameView); // Add gameView to stackedWidget
+    gameView->setEndgamePool(endgamePool);
 
     setCentralWidget(stackedWidget);
 
@@ -34,11 +42,20 @@ MainWindow::MainWindow(QWidget *parent)
     connect(startPageController, &StartPageController::navigateToHome, this, &MainWindow::showHomePage);
     connect(settingsPageController, &SettingsPageController::navigateToHome, this, &MainWindow::showHomePage);
     connect(settingsPageController, &SettingsPageController::setFullscreen, this, &MainWindow::toggleFullscreen);
+    connect(settingsPageController, &SettingsPageController::setPondering, gameView, &GameView::setPonderingEnabled);
+    connect(settingsPageController, &SettingsPageController::setEndgameDifficulty, endgamePool, &EndgamePool::setDifficulty);
+    endgamePool->setDifficulty(settingsPageController->getEndgameDifficulty());
     connect(gameView, &GameView::navigateToHome, this, &MainWindow::showHomePage);
 
     // Direct connection now possible as StartPageController::startGame emits BoardType
     connect(startPageController, &StartPageController::startGame, this, &MainWindow::startGame);
 
+    // Tracing builds save what they recorded on demand, to see where hint latency goes
+    if (pegcore::Trace::Enabled) {
+        QShortcut *traceShortcut = new QShortcut(QKeySequence("Ctrl+Shift+T"), this);
+        connect(traceShortcut, &QShortcut::activated, this, &MainWindow::exportTrace);
+    }
+
     showHomePage(); // Show home page initially
     setWindowTitle("Peg Solitaire");
     resize(800, 600); // Adjusted default size for better board visibility
@@ -69,7 +86,7 @@ void MainWindow::showSettingsPage() // Add this function
 
 void MainWindow::startGame(BoardType boardType)
 {
-    qDebug() << "Main window: Attempting to start game with board type (enum):" << static_cast<int>(boardType);
+    qCDebug(lcApp) << "Main window: Attempting to start game with board type (enum):" << static_cast<int>(boardType);
 
     // Clean up previous board model if it exists
     if (currentBoardModel)
@@ -97,23 +114,24 @@ void MainWindow::startGame(BoardType boardType)
             break;
         case BoardType::Endgame:
             currentBoardModel = new Board(BoardType::Endgame, this);
+            currentBoardModel->loadState(BoardType::Endgame, endgamePool->take());
             break;
         default:
-            qDebug() << "Main window: Unknown or unsupported board type (enum):" << static_cast<int>(boardType);
+            qCDebug(lcApp) << "Main window: Unknown or unsupported board type (enum):" << static_cast<int>(boardType);
             currentBoardModel = new Board(BoardType::English, this); // Fallback
             break;
     }
 
     if (currentBoardModel)
     {
-        qDebug() << "Main window: Board model created with type (enum):" << static_cast<int>(currentBoardModel->getBoardType())
+        qCDebug(lcApp) << "Main window: Board model created with type (enum):" << static_cast<int>(currentBoardModel->getBoardType())
                  << "Pegs:" << currentBoardModel->getPegCount();
         gameView->setBoard(currentBoardModel);
         stackedWidget->setCurrentWidget(gameView); // Switch to the game view
     }
     else
     {
-        qDebug() << "Main window: Failed to create board model for type:" << static_cast<int>(boardType);
+        qCDebug(lcApp) << "Main window: Failed to create board model for type:" << static_cast<int>(boardType);
         showHomePage(); // Fallback to home page if board creation fails
     }
 }
@@ -129,3 +147,18 @@ void MainWindow::toggleFullscreen(bool fullscreen) // Add this function
         showNormal();
     }
 }
+
+void MainWindow::exportTrace()
+{
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    QDir().mkpath(dir);
+    QString path = dir + "/trace-" + QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss") + ".json";
+    if (pegcore::Trace::writeChromeJson(QFile::encodeName(path).toStdString()))
+    {
+        qCInfo(lcApp) << "Main window: Trace saved to" << path << "(open in ui.perfetto.dev or chrome://tracing)";
+    }
+    else
+    {
+        qCWarning(lcApp) << "Main window: Could not write trace to" << path;
+    }
+}
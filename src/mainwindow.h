@@ -12,6 +12,7 @@
 #include "views/GameView.h" // Added
 #include "controllers/BoardController.h" // Added  
 #include "models/Board.h"    // Added
+#include "controllers/EndgamePool.h"
 
 class MainWindow : public QMainWindow
 {
@@ -27,6 +28,10 @@ private slots:
     void showSettingsPage();
     void startGame(BoardType boardType); // Changed QString to BoardType
     void toggleFullscreen(bool fullscreen);
+    /**
+     * @brief Save the trace buffers as Chrome trace JSON in the app data folder
+     */
+    void exportTrace();
 
 private:
     HomePageView *homePageView;
@@ -37,6 +42,7 @@ private:
     GameView *gameView; // Changed from BoardView
     BoardController *boardController; // Added
     Board *currentBoardModel; // Added
+    EndgamePool *endgamePool; // Generates endgame positions ahead of time
 
     QStackedWidget *stackedWidget; // Replace currentView
 };
@@ -1,15 +1,18 @@
 #include "models/Board.h"
+#include "core/Trace.h"
 #include <QVector>
 #include <stdexcept>
-#include <QDebug>
+#include "utils/Logging.h"
 
-Board::Board(QObject *parent) : QObject(parent), pegCount(0)
+Board::Board(QObject *parent)
+    : QObject(parent), core(pegcore::Board::starting(pegcore::Variant::English))
 {
     // Default constructor, initialize with a default board type
     initializeBoard(BoardType::English);
 }
 
-Board::Board(BoardType boardType, QObject *parent) : QObject(parent), pegCount(0)
+Board::Board(BoardType boardType, QObject *parent)
+    : QObject(parent), core(pegcore::Board::starting(pegcore::Variant::English))
 {
     initializeBoard(boardType);
 }
@@ -17,243 +20,212 @@ Board::Board(BoardType boardType, QObject *parent) : QObject(parent), pegCount(0
 void Board::initializeBoard(BoardType boardType)
 {
     this->currentBoardType = boardType;
-    pegCount = 0;
-    grid.clear();
-    moveHistory.clear();
 
     switch (boardType)
     {
         case BoardType::English:
-            setupEnglish();
+            core = pegcore::Board::starting(pegcore::Variant::English);
             break;
         case BoardType::Diamond:
-            setupDiamond();
+            core = pegcore::Board::starting(pegcore::Variant::Diamond);
             break;
         case BoardType::Square:
-            setupSquare();
+            core = pegcore::Board::starting(pegcore::Variant::Square);
             break;
         case BoardType::AntiPeg:
-            setupAntiPeg();
+            core = pegcore::Board::starting(pegcore::Variant::AntiPeg);
             break;
         case BoardType::Endgame:
             setupEndgame();
             break;
         default:
-            qWarning() << "Unknown or unsupported board type:" << static_cast<int>(boardType);
-            setupEnglish(); // Default fallback
+            qCWarning(lcBoard) << "Unknown or unsupported board type:" << static_cast<int>(boardType);
+            core = pegcore::Board::starting(pegcore::Variant::English); // Default fallback
             break;
     }
 }
 
+void Board::loadState(BoardType boardType, const QVector<QVector<PegState>> &cells)
+{
+    PEGCORE_TRACE_SCOPE("board", "load state");
+    const pegcore::Layout &layout = layoutFor(boardType);
+    pegcore::Rules rules = boardType == BoardType::AntiPeg ? pegcore::Rules::AntiPeg : pegcore::Rules::Normal;
+
+    // The game keeps a position in one quint64; wider layouts are engine-only
+    if (layout.stateWords() != 1)
+    {
+        qCWarning(lcBoard) << "Layout of board type" << static_cast<int>(boardType) << "has"
+                           << layout.cellCount() << "cells, more than a game board can hold";
+        initializeBoard(BoardType::English);
+        return;
+    }
+
+    // The cells have to match the layout exactly, blocked cells included
+    bool matches = cells.size() == layout.rows();
+    quint64 pegs = 0;
+    for (int r = 0; r < cells.size() && matches; ++r)
+    {
+        matches = cells[r].size() == layout.cols();
+        for (int c = 0; c < cells[r].size() && matches; ++c)
+        {
+            int cell = layout.cellAt(r, c);
+            matches = (cell < 0) == (cells[r][c] == PegState::Blocked);
+            if (matches && cells[r][c] == PegState::Peg)
+            {
+                pegs |= 1ULL << cell;
+            }
+        }
+    }
+    if (!matches)
+    {
+        qCWarning(lcBoard) << "Board state does not fit the layout of board type" << static_cast<int>(boardType);
+        initializeBoard(boardType);
+        return;
+    }
+
+    this->currentBoardType = boardType;
+    core = pegcore::Board(layout, rules, pegs);
+}
+
+const pegcore::Layout &Board::layoutFor(BoardType boardType)
+{
+    switch (boardType)
+    {
+        case BoardType::Diamond:
+            return pegcore::Layout::diamond();
+        case BoardType::Square:
+            return pegcore::Layout::square();
+        default:
+            return pegcore::Layout::english();
+    }
+}
+
 PegState Board::getPegState(Position pos) const
 {
-    if (!isValidPosition(pos) || pos.row >= grid.size() || pos.col >= grid[pos.row].size())
+    int cell = core.layout().cellAt(pos.row, pos.col);
+    if (cell < 0)
     {
         return PegState::Blocked;
     }
-    return grid[pos.row][pos.col];
+    return core.cell(cell) == pegcore::Cell::Peg ? PegState::Peg : PegState::Empty;
 }
 
-void Board::setPegState(Position pos, PegState state)
+QVector<QVector<PegState>> Board::getCells() const
 {
-    if (isValidPosition(pos) && pos.row < grid.size() && pos.col < grid[pos.row].size())
+    PEGCORE_TRACE_SCOPE("board", "copy cells");
+    QVector<QVector<PegState>> cells(getRows());
+    for (int r = 0; r < getRows(); ++r)
     {
-        PegState oldState = grid[pos.row][pos.col];
-        grid[pos.row][pos.col] = state;
-
-        if (oldState == PegState::Peg && state != PegState::Peg)
+        cells[r].resize(getCols());
+        for (int c = 0; c < getCols(); ++c)
         {
-            pegCount--;
-        }
-        else if (oldState != PegState::Peg && state == PegState::Peg)
-        {
-            pegCount++;
+            cells[r][c] = getPegState({r, c});
         }
     }
-    else
+    return cells;
+}
+
+void Board::setPegState(Position pos, PegState state)
+{
+    int cell = core.layout().cellAt(pos.row, pos.col);
+    if (cell < 0 || state == PegState::Blocked)
     {
-        qWarning() << "Attempted to set peg state for invalid position:" << pos.row << pos.col;
+        // Copying a board cell by cell passes blocked cells along too
+        if (cell >= 0 || state != PegState::Blocked)
+        {
+            qCWarning(lcBoard) << "Attempted to set peg state for invalid position:" << pos.row << pos.col;
+        }
+        return;
     }
+    core.setCell(cell, state == PegState::Peg ? pegcore::Cell::Peg : pegcore::Cell::Empty);
 }
 
 bool Board::isValidPosition(Position pos) const
 {
-    if (pos.row < 0 || pos.row >= rows)
+    if (pos.row < 0 || pos.row >= getRows())
         return false;
-    return pos.col >= 0 && pos.col < cols;
+    return pos.col >= 0 && pos.col < getCols();
 }
 
 QVector<Move> Board::getValidMoves() const
 {
-    QVector<Move> moves;
-    // Standard 4-direction moves for rectangular boards
-    int dr[] = {-1, 1, 0, 0};
-    int dc[] = {0, 0, -1, 1};
+    QVector<Move> moves(getMaxMoveCount());
+    moves.resize(generateMoves(moves.data()));
+    return moves;
+}
 
-    if (isAntiPegMode()) {
-        // Anti-peg mode: peg jumps over empty cell to another empty cell, 
-        // leaving a peg in the jumped-over cell
-        for (int r = 0; r < rows; ++r)
-        {
-            for (int c = 0; c < cols; ++c)
-            {
-                if (getPegState({r, c}) == PegState::Peg)
-                {
-                    for (int i = 0; i < 4; ++i)
-                    {
-                        Position jumped(r + dr[i], c + dc[i]);
-                        Position to(r + 2 * dr[i], c + 2 * dc[i]);
-
-                        // In anti-peg mode: jump over empty to empty, placing peg in jumped position
-                        if (getPegState(jumped) == PegState::Empty && getPegState(to) == PegState::Empty)
-                        {
-                            moves.append({{r, c}, jumped, to});
-                        }
-                    }
-                }
-            }
-        }
-    } else {
-        // Normal mode: peg jumps over peg to empty cell, removing jumped peg
-        for (int r = 0; r < rows; ++r)
-        {
-            for (int c = 0; c < cols; ++c)
-            {
-                if (getPegState({r, c}) == PegState::Peg)
-                {
-                    for (int i = 0; i < 4; ++i)
-                    {
-                        Position jumped(r + dr[i], c + dc[i]);
-                        Position to(r + 2 * dr[i], c + 2 * dc[i]);
-
-                        if (getPegState(jumped) == PegState::Peg && getPegState(to) == PegState::Empty)
-                        {
-                            moves.append({{r, c}, jumped, to});
-                        }
-                    }
-                }
-            }
-        }
+int Board::generateMoves(Move *out) const
+{
+    // A cell starts at most 4 jumps, so this holds every move of any layout
+    pegcore::Move moves[pegcore::Layout::MaxCells * 4];
+    int count = core.generateMoves(moves);
+    for (int i = 0; i < count; ++i)
+    {
+        out[i] = fromCoreMove(moves[i]);
     }
-    return moves;
+    return count;
 }
 
-bool Board::performMove(const Move &move)
+int Board::getMaxMoveCount() const
 {
-    if (isAntiPegMode()) {
-        // Anti-peg mode validation: peg jumps over empty to empty, placing peg in jumped cell
-        if (getPegState(move.from) == PegState::Peg &&
-            getPegState(move.jumped) == PegState::Empty &&
-            getPegState(move.to) == PegState::Empty)
-        {
-            bool validJumpPath = false;
-            // Standard rectangular jump validation
-            int dr[] = {-1, 1, 0, 0};
-            int dc[] = {0, 0, -1, 1};
-            for (int i = 0; i < 4; ++i)
-            {
-                if (move.jumped.row == move.from.row + dr[i] &&
-                    move.jumped.col == move.from.col + dc[i] &&
-                    move.to.row == move.from.row + 2 * dr[i] &&
-                    move.to.col == move.from.col + 2 * dc[i])
-                {
-                    validJumpPath = true;
-                    break;
-                }
-            }
+    return core.maxMoveCount();
+}
 
-            if (validJumpPath)
-            {
-                // Store move in history for undo
-                moveHistory.append(move);
-                
-                // Perform anti-peg move: move peg to destination, place peg in jumped cell
-                setPegState(move.from, PegState::Empty);
-                setPegState(move.jumped, PegState::Peg);    // Place peg in jumped cell
-                setPegState(move.to, PegState::Peg);
-                return true;
-            }
-        }
-    } else {
-        // Normal mode validation: peg jumps over peg to empty, removing jumped peg
-        if (getPegState(move.from) == PegState::Peg &&
-            getPegState(move.jumped) == PegState::Peg &&
-            getPegState(move.to) == PegState::Empty)
-        {
-            bool validJumpPath = false;
-            // Standard rectangular jump validation
-            int dr[] = {-1, 1, 0, 0};
-            int dc[] = {0, 0, -1, 1};
-            for (int i = 0; i < 4; ++i)
-            {
-                if (move.jumped.row == move.from.row + dr[i] &&
-                    move.jumped.col == move.from.col + dc[i] &&
-                    move.to.row == move.from.row + 2 * dr[i] &&
-                    move.to.col == move.from.col + 2 * dc[i])
-                {
-                    validJumpPath = true;
-                    break;
-                }
-            }
+int Board::getPlayableCellCount() const
+{
+    return core.layout().cellCount();
+}
 
-            if (validJumpPath)
-            {
-                // Store move in history for undo
-                moveHistory.append(move);
-                
-                // Perform normal move: move peg to destination, remove jumped peg
-                setPegState(move.from, PegState::Empty);
-                setPegState(move.jumped, PegState::Empty);  // Remove jumped peg
-                setPegState(move.to, PegState::Peg);
-                return true;
-            }
-        }
-    }
-    return false;
+bool Board::performMove(const Move &move)
+{
+    // Normal mode: peg jumps over peg to empty cell, removing jumped peg.
+    // Anti-peg mode: peg jumps over empty cell to another empty cell,
+    // leaving a peg in the jumped-over cell
+    pegcore::Move coreMove;
+    return toCoreMove(move, coreMove) && core.play(coreMove);
 }
 
 bool Board::undoLastMove()
 {
-    if (moveHistory.isEmpty()) {
-        return false;
-    }
-    
-    // Get the last move from history
-    Move lastMove = moveHistory.takeLast();
-    
-    if (isAntiPegMode()) {
-        // Reverse anti-peg move: remove peg from destination and jumped cell, restore original peg
-        setPegState(lastMove.to, PegState::Empty);       // Remove peg from destination
-        setPegState(lastMove.jumped, PegState::Empty);   // Remove peg from jumped cell
-        setPegState(lastMove.from, PegState::Peg);       // Restore original peg
-    } else {
-        // Reverse normal move: remove peg from destination, restore jumped peg, restore original peg
-        setPegState(lastMove.to, PegState::Empty);       // Remove peg from destination
-        setPegState(lastMove.jumped, PegState::Peg);     // Restore jumped peg
-        setPegState(lastMove.from, PegState::Peg);       // Restore original peg
+    return core.undo();
+}
+
+Move Board::getLastMove() const
+{
+    if (core.historySize() == 0) {
+        return {{-1, -1}, {-1, -1}, {-1, -1}};
     }
-    
-    return true;
+    return fromCoreMove(core.lastMove());
 }
 
 int Board::getRows() const
 {
-    return rows;
+    return core.layout().rows();
 }
 
 int Board::getCols() const
 {
-    return cols;
+    return core.layout().cols();
 }
 
 int Board::getPegCount() const
 {
-    return pegCount;
+    return core.pegCount();
+}
+
+int Board::getEmptyCount() const
+{
+    return core.emptyCount();
+}
+
+int Board::getMobility() const
+{
+    return core.mobility();
 }
 
 bool Board::isGameOver() const
 {
-    return getValidMoves().isEmpty();
+    return core.isGameOver();
 }
 
 BoardType Board::getBoardType() const
@@ -268,106 +240,90 @@ bool Board::isAntiPegMode() const
 
 bool Board::isWinningState() const
 {
-    if (isAntiPegMode()) {
-        // Anti-peg mode: win when no more moves available AND
-        // the starting position (where the first peg was) is the only empty cell
-        if (!getValidMoves().isEmpty()) {
-            return false; // Still moves available
-        }
-        
-        // Count empty cells and check if starting position is empty
-        int emptyCells = 0;
-        
-        for (int r = 0; r < rows; ++r) {
-            for (int c = 0; c < cols; ++c) {
-                Position pos(r, c);
-                if (getPegState(pos) == PegState::Empty) {
-                    emptyCells++;
-                }
-            }
-        }
-        
-        // Win if exactly one empty cell and it's at the starting position
-        return (emptyCells == 1);
-    } else {
-        // Normal mode: win when exactly 1 peg remains
-        return pegCount == 1;
-    }
+    return core.isWin();
 }
 
 quint64 Board::getBoardStateId() const
 {
-    QVector<quint64> allIds = getAllSymmetricStateIds();
-    
-    // Return the minimum ID as the canonical representation
-    quint64 minId = allIds[0];
-    for (const quint64& id : allIds) {
-        if (id < minId) {
-            minId = id;
-        }
-    }
-    
-    return minId;
+    // Endgame boards have the English layout and rules, so they share its ids
+    return core.canonicalId();
+}
+
+quint64 Board::getStateBits() const
+{
+    return core.pegs();
 }
 
 QVector<quint64> Board::getAllSymmetricStateIds() const
 {
     QVector<quint64> ids;
-    ids.reserve(8);
-    
-    // Generate all 8 symmetric variations:
-    // 4 rotations (0°, 90°, 180°, 270°) × 2 (original and flipped)
-    for (int flip = 0; flip < 2; ++flip) {
-        for (int rotation = 0; rotation < 4; ++rotation) {
-            ids.append(boardToBits(rotation, flip == 1));
-        }
+    const pegcore::Layout &layout = core.layout();
+    ids.reserve(layout.symmetryCount());
+    for (int symmetry = 0; symmetry < layout.symmetryCount(); ++symmetry) {
+        ids.append(layout.transform(symmetry, core.pegs()));
     }
-    
     return ids;
 }
 
-quint64 Board::boardToBits(int rotations, bool flip) const
-{
-    quint64 result = 0;
-    int bitIndex = 0;
-    
-    // Traverse the board in row-major order, applying transformations
-    for (int r = 0; r < rows; ++r) {
-        for (int c = 0; c < cols; ++c) {
-            Position originalPos(r, c);
-            Position transformedPos = getTransformedPosition(originalPos, rotations, flip);
-            
-            // Get the state at the transformed position
-            PegState state = getPegState(transformedPos);
-            
-            // Convert to bit: 1 for peg, 0 for empty/blocked
+pegcore::Board &Board::getCoreBoard()
+{
+    return core;
+}
+
+const pegcore::Board &Board::getCoreBoard() const
+{
+    return core;
+}
+
+bool Board::toCoreMove(const Move &move, pegcore::Move &coreMove) const
+{
+    const pegcore::Layout &layout = core.layout();
+    int from = layout.cellAt(move.from.row, move.from.col);
+    int over = layout.cellAt(move.jumped.row, move.jumped.col);
+    int to = layout.cellAt(move.to.row, move.to.col);
+    if (from < 0 || over < 0 || to < 0) {
+        return false;
+    }
+    coreMove = {pegcore::CellIndex(from), pegcore::CellIndex(over), pegcore::CellIndex(to)};
+    return true;
+}
+
+Move Board::fromCoreMove(const pegcore::Move &coreMove) const
+{
+    const pegcore::Layout &layout = core.layout();
+    return {{layout.rowOf(coreMove.from), layout.colOf(coreMove.from)},
+            {layout.rowOf(coreMove.over), layout.colOf(coreMove.over)},
+            {layout.rowOf(coreMove.to), layout.colOf(coreMove.to)}};
+}
+
+BoardType Board::dualBoardType(BoardType boardType)
+{
+    return boardType == BoardType::AntiPeg ? BoardType::English : boardType;
+}
+
+QVector<QVector<PegState>> Board::dualCells(BoardType boardType, const QVector<QVector<PegState>> &cells)
+{
+    if (boardType != BoardType::AntiPeg) {
+        return cells;
+    }
+
+    QVector<QVector<PegState>> dual = cells;
+    for (QVector<PegState> &row : dual) {
+        for (PegState &state : row) {
             if (state == PegState::Peg) {
-                result |= (1ULL << bitIndex);
+                state = PegState::Empty;
+            } else if (state == PegState::Empty) {
+                state = PegState::Peg;
             }
-            
-            bitIndex++;
         }
     }
-    
-    return result;
+    return dual;
 }
 
-Position Board::getTransformedPosition(const Position& pos, int rotations, bool flip) const
+Move Board::dualMove(BoardType boardType, const Move &move)
 {
-    Position transformed = pos;
-    
-    // Apply horizontal flip first if needed
-    if (flip) {
-        transformed.col = cols - 1 - transformed.col;
-    }
-    
-    // Apply rotations (90-degree clockwise rotations)
-    for (int i = 0; i < rotations; ++i) {
-        int newRow = transformed.col;
-        int newCol = rows - 1 - transformed.row;
-        transformed.row = newRow;
-        transformed.col = newCol;
+    if (boardType != BoardType::AntiPeg || move.from.row == -1) {
+        return move;
     }
-    
-    return transformed;
-}
\ No newline at end of file
+    return {move.to, move.jumped, move.from};
+}
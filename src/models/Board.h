@@ -5,8 +5,7 @@
 #include <QVector> // Added for QVector
 #include <QPair>   // Added for QPair (used in Position)
 #include <QObject> // Added for QObject inheritance
-#include <QSet>    // Added for symmetry optimization
-#include <QMutex>  // Added for thread safety
+#include "core/Board.h"
 
 // Enum to represent the type of board
 enum class BoardType
@@ -61,6 +60,17 @@ struct Move
     Position to;
 };
 
+/**
+ * @brief Qt front end of the engine's pegcore::Board
+ *
+ * Keeps the grid-based API the controllers and views use (rows, columns and
+ * Position/Move structs) and translates it to and from the engine's cell
+ * indices. Rules, state and move generation all live in the engine.
+ *
+ * Positions are held in a single quint64 (pegcore::Board), so only layouts
+ * that fit one state word can be played here. The wider multi-word states of
+ * larger layouts are available to the engine and the command-line tools only.
+ */
 class Board : public QObject
 {
     Q_OBJECT
@@ -71,15 +81,76 @@ public:
 
     // Board functions - no longer pure virtual
     void initializeBoard(BoardType boardType);
+    /**
+     * @brief Load an exact board state without running the layout setup
+     *
+     * The cells must have the layout of the board type; otherwise the board
+     * is set up from scratch instead. A layout too wide for one quint64 is
+     * refused, and the English board is set up in its place.
+     *
+     * @param boardType The type of board the cells belong to
+     * @param cells Cell states, row by row
+     */
+    void loadState(BoardType boardType, const QVector<QVector<PegState>> &cells);
     QVector<Move> getValidMoves() const;
+    /**
+     * @brief Write all valid moves into a caller-provided buffer
+     * @param out Buffer with room for at least getMaxMoveCount() moves
+     * @return Number of moves written
+     */
+    int generateMoves(Move *out) const;
+    /**
+     * @brief Upper bound on the number of moves any position of this layout can have
+     * @return Maximum number of moves generateMoves() can write
+     */
+    int getMaxMoveCount() const;
+    /**
+     * @brief Count the cells that are part of the playable board
+     * @return Number of non-blocked cells
+     */
+    int getPlayableCellCount() const;
     bool performMove(const Move &move);
     bool undoLastMove();
+    /**
+     * @brief Get the move undoLastMove() would take back
+     * @return The last move played, or a move with row -1 everywhere if there is none
+     */
+    Move getLastMove() const;
     PegState getPegState(Position pos) const;
+    /**
+     * @brief Get a copy of all cell states
+     * @return Cell states, row by row
+     */
+    QVector<QVector<PegState>> getCells() const;
+    /**
+     * @brief Change a playable cell to a peg or a hole
+     *
+     * The layout is fixed by the board type, so cells cannot be made blocked
+     * or playable.
+     *
+     * @param pos The cell
+     * @param state PegState::Peg or PegState::Empty
+     */
     void setPegState(Position pos, PegState state);
     bool isValidPosition(Position pos) const;
     int getRows() const;
     int getCols() const;
     int getPegCount() const;
+    /**
+     * @brief Count the empty playable cells
+     * @return Number of empty cells, kept up to date on every cell change
+     */
+    int getEmptyCount() const;
+    /**
+     * @brief Count the valid moves of the current position
+     * @return Number of moves getValidMoves() would return, kept up to date
+     *         on every cell change
+     */
+    int getMobility() const;
+    /**
+     * @brief Check if no move is left; O(1) from the mobility counter
+     * @return True if the position has no valid moves
+     */
     bool isGameOver() const;
     BoardType getBoardType() const;
       /**
@@ -90,54 +161,106 @@ public:
    
     /**
      * @brief Check if the current board state represents a win
+     *
+     * O(1): answered from the peg, empty-cell and mobility counters.
+     *
      * @return True if the board is in a winning state
      */
     bool isWinningState() const;
     
     /**
      * @brief Get unique identifier for current board state based on symmetries
+     *
+     * The top bits identify the layout and rules, so ids of different board
+     * types never collide; Endgame boards share English ids.
+     *
      * @return 64-bit unique identifier representing this board state
      */
     quint64 getBoardStateId() const;
+
+    /**
+     * @brief Get identifier of the exact board state, without symmetry reduction
+     * @return 64-bit representation of the current peg layout; every game
+     *         board fits one word (see loadState())
+     */
+    quint64 getStateBits() const;
     
     /**
-     * @brief Get all 8 symmetric variations of the board state as unique IDs
-     * @return Vector of 8 unique identifiers for all symmetrical variants
+     * @brief Get the state bits of every symmetric variant of the board state
+     * @return One entry per symmetry of the layout, the identity first
      */
     QVector<quint64> getAllSymmetricStateIds() const;
 
+    /**
+     * @brief Get the engine position behind this board
+     * @return The engine board; moves played on it show up here
+     */
+    pegcore::Board &getCoreBoard();
+    const pegcore::Board &getCoreBoard() const;
+
+    /**
+     * @brief Convert a move to the engine's cell indices
+     * @param move The move
+     * @param coreMove Set to the converted move
+     * @return False if a cell of the move is not on the board
+     */
+    bool toCoreMove(const Move &move, pegcore::Move &coreMove) const;
+
+    /**
+     * @brief Convert an engine move to grid positions
+     * @param coreMove The engine move
+     * @return The move
+     */
+    Move fromCoreMove(const pegcore::Move &coreMove) const;
+
+    /**
+     * @brief Get the board type whose rules a position is solved under
+     *
+     * Anti-peg is normal solitaire played backwards: complementing a position
+     * turns every anti-peg move into a normal move with from and to swapped,
+     * and the anti-peg win (one empty hole) into the normal win (one peg).
+     * Anti-peg positions are therefore solved as their complement on the
+     * English board, which shares its layout.
+     *
+     * @param boardType The type of board being played
+     * @return The type the solver should run on
+     */
+    static BoardType dualBoardType(BoardType boardType);
+
+    /**
+     * @brief Map a position to the one it is solved as (see dualBoardType())
+     * @param boardType The type of board being played
+     * @param cells Cell states, row by row
+     * @return The complemented cells for anti-peg, otherwise the cells unchanged
+     */
+    static QVector<QVector<PegState>> dualCells(BoardType boardType, const QVector<QVector<PegState>> &cells);
+
+    /**
+     * @brief Map a move between a position and its dual (see dualBoardType())
+     *
+     * The mapping is its own inverse, so it converts moves in either direction.
+     *
+     * @param boardType The type of board being played
+     * @param move The move to map
+     * @return The move with from and to swapped for anti-peg, otherwise unchanged
+     */
+    static Move dualMove(BoardType boardType, const Move &move);
+
 private:
-    // Board setup methods
-    void setupEnglish();
-    void setupDiamond();
-    void setupSquare();
-    void setupAntiPeg();  // Anti-peg mode setup
-    void setupEndgame();  // Endgame mode setup// Board data
-    QVector<QVector<PegState>> grid;
-    int rows;
-    int cols;
-    int pegCount;
-
-    /**
-     * @brief Convert board state to bit string in specified traversal order
-     * @param rotations Number of 90-degree rotations (0-3)
-     * @param flip Whether to flip horizontally before rotation
-     * @return 64-bit representation of board state
-     */
-    quint64 boardToBits(int rotations, bool flip) const;
-    
     /**
-     * @brief Get position after applying transformations
-     * @param pos Original position
-     * @param rotations Number of 90-degree rotations (0-3)
-     * @param flip Whether to flip horizontally before rotation
-     * @return Transformed position
+     * @brief Set up a random endgame that is solvable by construction
+     */
+    void setupEndgame();
+
+    /**
+     * @brief Get the engine layout a board type is played on
+     * @param boardType The board type
+     * @return The layout; Endgame and AntiPeg use the English one
      */
-    Position getTransformedPosition(const Position& pos, int rotations, bool flip) const;
+    static const pegcore::Layout &layoutFor(BoardType boardType);
 
-protected:
     BoardType currentBoardType;
-    QVector<Move> moveHistory; // Track move history for undo
+    pegcore::Board core; // Position, rules and move history
 };
 
 #endif // BOARD_H
@@ -0,0 +1,142 @@
+#include "models/EndgameGenerator.h"
+#include "utils/Logging.h"
+#include <QMutexLocker>
+
+EndgameTarget EndgameTarget::forDifficulty(EndgameDifficulty difficulty)
+{
+    // Bounds sit around the quartiles of the winning-line counts measured on
+    // random backward play at each peg count
+    switch (difficulty)
+    {
+        case EndgameDifficulty::Easy:
+            return {8, 60, 0};
+        case EndgameDifficulty::Hard:
+            return {14, 0, 150000};
+        case EndgameDifficulty::Medium:
+        default:
+            return {11, 200, 4000};
+    }
+}
+
+EndgameGenerator::EndgameGenerator(quint32 seed, TranspositionTable *table)
+    : rng(seed),
+      seenIds(&ownSeenIds),
+      seenIdsMutex(nullptr),
+      countBoard(BoardType::Endgame),
+      counter(&countBoard, table),
+      winningLines(0),
+      attempts(0)
+{
+}
+
+bool EndgameGenerator::generate(const EndgameTarget &target, QVector<QVector<PegState>> &cells,
+                                const StopToken *stopToken, int maxAttempts)
+{
+    attempts = 0;
+    while (attempts < maxAttempts) {
+        if (stopToken && stopToken->stopRequested()) {
+            return false;
+        }
+        attempts++;
+
+        QVector<QVector<PegState>> candidate;
+        if (!playBackwards(target.pegCount, rng, candidate)) {
+            continue;
+        }
+
+        countBoard.loadState(BoardType::Endgame, candidate);
+        quint64 stateId = countBoard.getBoardStateId();
+        {
+            QMutexLocker locker(seenIdsMutex);
+            if (seenIds->contains(stateId)) {
+                continue;
+            }
+        }
+        if (!counter.count(stopToken)) {
+            return false;
+        }
+
+        SolutionCount lines = counter.result();
+        quint64 lineCount = lines.high != 0 ? ~quint64(0) : lines.low;
+        if (lineCount < target.minWinningLines ||
+            (target.maxWinningLines != 0 && lineCount > target.maxWinningLines)) {
+            continue;
+        }
+
+        {
+            // Another generator sharing the set may have claimed it meanwhile
+            QMutexLocker locker(seenIdsMutex);
+            if (!claimSeenId(*seenIds, stateId)) {
+                continue;
+            }
+        }
+        winningLines = lineCount;
+        cells = candidate;
+        return true;
+    }
+
+    qCDebug(lcEndgame) << "No endgame with" << target.pegCount << "pegs and"
+             << target.minWinningLines << "to" << target.maxWinningLines
+             << "winning lines after" << attempts << "attempts";
+    return false;
+}
+
+void EndgameGenerator::shareSeenIds(QSet<quint64> *ids, QMutex *mutex)
+{
+    seenIds = ids;
+    seenIdsMutex = mutex;
+}
+
+bool EndgameGenerator::claimSeenId(QSet<quint64> &ids, quint64 stateId)
+{
+    if (ids.contains(stateId)) {
+        return false;
+    }
+    if (ids.size() >= MaxSeenIds) {
+        ids.clear();
+    }
+    ids.insert(stateId);
+    return true;
+}
+
+quint64 EndgameGenerator::lastWinningLines() const
+{
+    return winningLines;
+}
+
+int EndgameGenerator::lastAttempts() const
+{
+    return attempts;
+}
+
+bool EndgameGenerator::playBackwards(int pegCount, QRandomGenerator &rng, QVector<QVector<PegState>> &cells)
+{
+    // Start from a single peg on an otherwise empty English board
+    cells = Board(BoardType::English).getCells();
+    QVector<Position> playable;
+    for (int r = 0; r < cells.size(); ++r) {
+        for (int c = 0; c < cells[r].size(); ++c) {
+            if (cells[r][c] != PegState::Blocked) {
+                cells[r][c] = PegState::Empty;
+                playable.append(Position(r, c));
+            }
+        }
+    }
+    Position start = playable[rng.bounded(int(playable.size()))];
+    cells[start.row][start.col] = PegState::Peg;
+
+    // An anti-peg move is exactly a jump played backwards: the peg leaves its
+    // cell and puts a peg on both the jumped and the landing cell
+    Board backwards;
+    backwards.loadState(BoardType::AntiPeg, cells);
+    for (int pegs = 1; pegs < pegCount; ++pegs) {
+        QVector<Move> moves = backwards.getValidMoves();
+        if (moves.isEmpty()) {
+            return false;
+        }
+        backwards.performMove(moves[rng.bounded(int(moves.size()))]);
+    }
+
+    cells = backwards.getCells();
+    return true;
+}
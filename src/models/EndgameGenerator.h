@@ -0,0 +1,138 @@
+#ifndef ENDGAMEGENERATOR_H
+#define ENDGAMEGENERATOR_H
+
+#include <QMutex>
+#include <QRandomGenerator>
+#include <QSet>
+#include <QVector>
+#include "models/Board.h"
+#include "models/SolutionCounter.h"
+#include "models/StopToken.h"
+#include "models/TranspositionTable.h"
+
+enum class EndgameDifficulty
+{
+    Easy,
+    Medium,
+    Hard
+};
+
+/**
+ * @brief What a generated endgame position should look like
+ *
+ * The number of winning lines grows steeply with the peg count, so the bounds
+ * only make sense together with it: for a fixed peg count, fewer winning lines
+ * mean fewer ways to go right and a harder puzzle.
+ */
+struct EndgameTarget
+{
+    int pegCount;            // Pegs in the starting position
+    quint64 minWinningLines; // Fewest distinct winning move sequences accepted
+    quint64 maxWinningLines; // Most winning move sequences accepted, 0 for no limit
+
+    /**
+     * @brief Get the target used for a difficulty level
+     * @param difficulty The difficulty level
+     * @return Peg count and winning-line bounds of the level
+     */
+    static EndgameTarget forDifficulty(EndgameDifficulty difficulty);
+};
+
+/**
+ * @brief Generates verified endgame positions on the English board
+ *
+ * Positions are built by playing random moves backwards from a single peg, so
+ * every position is solvable by construction. Each candidate is then measured
+ * by counting its winning lines (see SolutionCounter) and kept only if the
+ * count lies within the target's bounds. Candidates whose canonical state id
+ * was generated before, directly or as a symmetric image, are rejected.
+ * Generators that hand out positions to the same player can share the set of
+ * ids seen (see shareSeenIds()).
+ *
+ * The counter's memo is kept between candidates, so later counts reuse the
+ * subtrees shared with earlier ones.
+ */
+class EndgameGenerator
+{
+public:
+    /**
+     * @brief Create a generator
+     * @param seed Seed of the generator's random sequence
+     * @param table Shared table of positions proven won or lost, or null
+     */
+    explicit EndgameGenerator(quint32 seed, TranspositionTable *table = nullptr);
+
+    /**
+     * @brief Generate a position meeting the target
+     * @param target Peg count and winning-line bounds to meet
+     * @param cells Receives the position, row by row, if one was found
+     * @param stopToken Polled between candidates and during counts. May be null.
+     * @param maxAttempts Candidates to try before giving up
+     * @return True if a position was found, false if none was or it was stopped
+     */
+    bool generate(const EndgameTarget &target, QVector<QVector<PegState>> &cells,
+                  const StopToken *stopToken = nullptr, int maxAttempts = DefaultMaxAttempts);
+
+    /**
+     * @brief Use a set of seen canonical ids shared with other generators
+     *
+     * The generator then rejects positions any of them produced, and records
+     * its own in the shared set. Call before the first generate().
+     *
+     * @param ids The shared set; must outlive the generator
+     * @param mutex Guards the set; held only briefly, never across a count
+     */
+    void shareSeenIds(QSet<quint64> *ids, QMutex *mutex);
+
+    /**
+     * @brief Record a canonical id as handed out, unless it already was
+     *
+     * Drops all remembered ids first once MaxSeenIds of them have piled up.
+     *
+     * @param ids The set of seen ids
+     * @param stateId Canonical state id of the position
+     * @return False if the id was already in the set
+     */
+    static bool claimSeenId(QSet<quint64> &ids, quint64 stateId);
+
+    /**
+     * @brief Get the winning lines of the last generated position
+     * @return Number of winning lines, 0 before the first success
+     */
+    quint64 lastWinningLines() const;
+
+    /**
+     * @brief Get the candidates the last generate() call tried
+     * @return Number of candidates
+     */
+    int lastAttempts() const;
+
+    /**
+     * @brief Play random moves backwards from a single peg
+     *
+     * Every step undoes a jump, adding one peg, so the position reached can be
+     * played forwards back to the single peg.
+     *
+     * @param pegCount Pegs the position should have
+     * @param rng Random source
+     * @param cells Receives the position on the English layout, row by row
+     * @return False if the backward play got stuck before reaching pegCount
+     */
+    static bool playBackwards(int pegCount, QRandomGenerator &rng, QVector<QVector<PegState>> &cells);
+
+private:
+    static constexpr int DefaultMaxAttempts = 200;
+    // Canonical ids remembered for duplicate rejection before they are dropped
+    static constexpr int MaxSeenIds = 1 << 14;
+
+    QRandomGenerator rng;
+    QSet<quint64> ownSeenIds;
+    QSet<quint64> *seenIds; // ownSeenIds unless shared
+    QMutex *seenIdsMutex;   // Guards a shared seenIds, null otherwise
+    Board countBoard;
+    SolutionCounter counter;
+    quint64 winningLines;
+    int attempts;
+};
+
+#endif // ENDGAMEGENERATOR_H
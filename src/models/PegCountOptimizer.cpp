@@ -0,0 +1,226 @@
+#include "models/PegCountOptimizer.h"
+
+PegCountOptimizer::PegCountOptimizer(Board *board, TranspositionTable *table)
+    : board(board),
+      table(table),
+      stopToken(nullptr),
+      maxMovesPerPly(0),
+      incumbentCount(-1),
+      finishWeight(0),
+      interrupted(false),
+      nodesSearched(0)
+{
+    if (!board) {
+        return;
+    }
+
+    // Every move removes exactly one piece, which bounds the line length
+    maxMovesPerPly = board->getMaxMoveCount();
+    moveBuffer.resize((board->getPlayableCellCount() + 1) * maxMovesPerPly);
+}
+
+bool PegCountOptimizer::optimize(const StopToken *stopToken)
+{
+    if (!board) {
+        return false;
+    }
+
+    this->stopToken = stopToken;
+    interrupted = false;
+    if (memo.size() > MaxMemoEntries) {
+        memo.clear();
+    }
+    path.clear();
+    incumbent.clear();
+    incumbentCount = -1;
+
+    prepareFinishPagodas();
+    int target = lowerBound(board);
+    quint64 rootId = board->getBoardStateId();
+    if (target < 2 && table && table->isKnownFailure(rootId)) {
+        // The solver already ruled out a single-piece finish
+        target = 2;
+    }
+    if (target == 1 && !canFinishWithOnePiece()) {
+        target = 2;
+    }
+    target = qMax<int>(target, memo.value(rootId, 0));
+
+    // Every pass either finds a line or raises the bound; a full line always
+    // ends with no more pieces than there are now, so this terminates
+    while (!search(target, 0)) {
+        if (interrupted) {
+            return false;
+        }
+        target++;
+    }
+    return true;
+}
+
+int PegCountOptimizer::bestPieceCount() const
+{
+    return incumbentCount;
+}
+
+QVector<Move> PegCountOptimizer::bestLine() const
+{
+    return incumbent;
+}
+
+quint64 PegCountOptimizer::getNodesSearched() const
+{
+    return nodesSearched;
+}
+
+int PegCountOptimizer::lowerBound(const Board *board)
+{
+    PegState piece = board->isAntiPegMode() ? PegState::Empty : PegState::Peg;
+    int sumClasses[3] = {0, 0, 0};
+    int diffClasses[3] = {0, 0, 0};
+    int pieces = 0;
+    for (int r = 0; r < board->getRows(); ++r) {
+        for (int c = 0; c < board->getCols(); ++c) {
+            if (board->getPegState({r, c}) == piece) {
+                sumClasses[(r + c) % 3]++;
+                diffClasses[(r - c + 3 * board->getCols()) % 3]++;
+                pieces++;
+            }
+        }
+    }
+    if (pieces <= 1) {
+        return pieces;
+    }
+
+    auto allSameParity = [](const int classes[3]) {
+        return ((classes[0] ^ classes[1]) & 1) == 0 && ((classes[1] ^ classes[2]) & 1) == 0;
+    };
+    return allSameParity(sumClasses) || allSameParity(diffClasses) ? 2 : 1;
+}
+
+bool PegCountOptimizer::search(int target, int ply)
+{
+    nodesSearched++;
+    if (stopToken && (nodesSearched & (StopToken::CheckInterval - 1)) == 0 &&
+        stopToken->stopRequested()) {
+        interrupted = true;
+        return false;
+    }
+
+    if (board->isGameOver()) {
+        int pieces = pieceCount();
+        offerIncumbent(pieces);
+        return pieces <= target;
+    }
+
+    quint64 stateId = board->getBoardStateId();
+    if (memo.value(stateId, 0) > target) {
+        return false;
+    }
+    if (target == 1 && table && table->isKnownFailure(stateId)) {
+        return false;
+    }
+    if (target == 1 && !canFinishWithOnePiece()) {
+        memo.insert(stateId, 2);
+        return false;
+    }
+
+    Move *moves = moveBuffer.data() + ply * maxMovesPerPly;
+    int moveCount = board->generateMoves(moves);
+
+    for (int i = 0; i < moveCount; ++i) {
+        if (!board->performMove(moves[i])) {
+            continue;
+        }
+        path.append(moves[i]);
+        bool reached = search(target, ply + 1);
+        path.removeLast();
+        board->undoLastMove();
+
+        if (reached) {
+            return true;
+        }
+        if (interrupted) {
+            return false;
+        }
+    }
+
+    // Refuted: this position cannot finish with target pieces or fewer
+    memo.insert(stateId, static_cast<quint8>(target + 1));
+    return false;
+}
+
+int PegCountOptimizer::pieceCount() const
+{
+    return board->isAntiPegMode() ? board->getEmptyCount() : board->getPegCount();
+}
+
+quint64 PegCountOptimizer::pieceBits() const
+{
+    const pegcore::Board &core = board->getCoreBoard();
+    return board->isAntiPegMode() ? ~core.pegs() & core.layout().allCells() : core.pegs();
+}
+
+void PegCountOptimizer::prepareFinishPagodas()
+{
+    const pegcore::Layout &layout = board->getCoreBoard().layout();
+    int cellCount = layout.cellCount();
+
+    // Parities of the differences between the class counts, for both class systems
+    auto classParities = [&layout](quint64 pieces) {
+        int sumClasses[3] = {0, 0, 0};
+        int diffClasses[3] = {0, 0, 0};
+        for (quint64 bits = pieces; bits != 0; bits &= bits - 1) {
+            int cell = pegcore::lowestBit(bits);
+            sumClasses[(layout.rowOf(cell) + layout.colOf(cell)) % 3]++;
+            diffClasses[(layout.rowOf(cell) - layout.colOf(cell) + 3 * layout.cols()) % 3]++;
+        }
+        return ((sumClasses[0] ^ sumClasses[1]) & 1) | ((sumClasses[1] ^ sumClasses[2]) & 1) << 1 |
+               ((diffClasses[0] ^ diffClasses[1]) & 1) << 2 | ((diffClasses[1] ^ diffClasses[2]) & 1) << 3;
+    };
+
+    int maxDistance = layout.rows() + layout.cols() - 2;
+    QVector<quint64> fibonacci(maxDistance + 3);
+    fibonacci[1] = 1;
+    for (int i = 2; i < fibonacci.size(); ++i) {
+        fibonacci[i] = fibonacci[i - 1] + fibonacci[i - 2];
+    }
+    finishWeight = fibonacci[maxDistance + 2];
+
+    int rootParities = classParities(pieceBits());
+    finishPagodas.clear();
+    for (int centre = 0; centre < cellCount; ++centre) {
+        if (classParities(1ULL << centre) != rootParities) {
+            continue;
+        }
+        for (int cell = 0; cell < cellCount; ++cell) {
+            int distance = qAbs(layout.rowOf(cell) - layout.rowOf(centre)) +
+                           qAbs(layout.colOf(cell) - layout.colOf(centre));
+            finishPagodas.append(fibonacci[maxDistance + 2 - distance]);
+        }
+    }
+}
+
+bool PegCountOptimizer::canFinishWithOnePiece() const
+{
+    int cellCount = board->getCoreBoard().layout().cellCount();
+    quint64 pieces = pieceBits();
+    for (int offset = 0; offset < finishPagodas.size(); offset += cellCount) {
+        quint64 weight = 0;
+        for (quint64 bits = pieces; bits != 0; bits &= bits - 1) {
+            weight += finishPagodas[offset + pegcore::lowestBit(bits)];
+        }
+        if (weight >= finishWeight) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PegCountOptimizer::offerIncumbent(int finalCount)
+{
+    if (incumbentCount >= 0 && finalCount >= incumbentCount) {
+        return;
+    }
+    incumbentCount = finalCount;
+    incumbent = path;
+}
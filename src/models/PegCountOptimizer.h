@@ -0,0 +1,151 @@
+#ifndef PEGCOUNTOPTIMIZER_H
+#define PEGCOUNTOPTIMIZER_H
+
+#include <QHash>
+#include <QVector>
+#include "models/Board.h"
+#include "models/StopToken.h"
+#include "models/TranspositionTable.h"
+
+/**
+ * @brief Branch-and-bound search for the fewest pieces a position can end with
+ *
+ * Where Solver only answers whether a single-peg finish exists, this finds the
+ * smallest number of pieces left when no move remains, together with a line
+ * that reaches it. Pieces are pegs in normal mode and holes in anti-peg mode.
+ *
+ * The search tightens its target one piece at a time: starting from a lower
+ * bound k, it asks whether k pieces can be reached and moves on to k + 1 only
+ * once that is refuted, so the first line found is optimal. Every position a
+ * pass refutes has its proven lower bound memoised per canonical state id,
+ * which prunes it in all later passes. The starting bound comes from the
+ * rule-of-three position classes and from positions the solver has already
+ * proven to have no single-piece finish, so the k = 1 pass is skipped on dead
+ * games.
+ *
+ * During the k = 1 pass every node is also bounded by pagoda functions. The
+ * rule-of-three classes fix which cells a lone piece can finish on, and each
+ * such cell has a pagoda function centred on it (see prepareFinishPagodas()).
+ * A node whose pieces weigh less than a lone piece on the centre under every
+ * one of them cannot finish with one piece. Pagoda functions only limit where
+ * the pieces can end up, not how many are left, so they do not bound the
+ * later passes.
+ *
+ * If the search is stopped it keeps the best line found so far, which makes it
+ * usable as an anytime search under a deadline. The memo is kept between
+ * searches on the same board, so later positions of a game start warm.
+ */
+class PegCountOptimizer
+{
+public:
+    /**
+     * @brief Create an optimiser searching on the given board
+     * @param board Board to search on; moves are applied and undone in place
+     * @param table Positions proven to have no single-piece finish, or null
+     */
+    PegCountOptimizer(Board *board, TranspositionTable *table = nullptr);
+
+    /**
+     * @brief Search the board's current position
+     * @param stopToken Polled every StopToken::CheckInterval nodes; when it fires
+     *                  the best line found so far is kept. May be null.
+     * @return True if the result is proven optimal, false if the search stopped early
+     */
+    bool optimize(const StopToken *stopToken);
+
+    /**
+     * @brief Get the fewest pieces the best line found ends with
+     * @return Piece count at the end of bestLine(), -1 before optimize()
+     */
+    int bestPieceCount() const;
+
+    /**
+     * @brief Get the best line found by the last optimize()
+     * @return Moves from the searched position to the end of the game
+     */
+    QVector<Move> bestLine() const;
+
+    /**
+     * @brief Get the number of nodes expanded since the optimiser was created
+     * @return Node count
+     */
+    quint64 getNodesSearched() const;
+
+    /**
+     * @brief Lower bound on the pieces left from the board's current position
+     *
+     * Every jump changes the piece count of each of the three cell classes
+     * (r + c) mod 3 by one, so the parities of their pairwise differences never
+     * change, and likewise for (r - c) mod 3. A single piece leaves exactly one
+     * class odd; positions whose classes are all of equal parity need at least two.
+     *
+     * @param board The position to bound
+     * @return Lower bound on the final piece count
+     */
+    static int lowerBound(const Board *board);
+
+private:
+    // Memo entries kept between searches before the memo is dropped
+    static constexpr int MaxMemoEntries = 1 << 21;
+
+    Board *board;
+    TranspositionTable *table;
+    const StopToken *stopToken;
+
+    QHash<quint64, quint8> memo; // Proven lower bound on the final pieces per canonical state id
+    QVector<Move> moveBuffer;    // Preallocated, maxMovesPerPly moves per ply
+    int maxMovesPerPly;
+    QVector<Move> path;          // Moves from the root to the current node
+    QVector<Move> incumbent;     // Best line found so far
+    int incumbentCount;
+    QVector<quint64> finishPagodas; // Pagoda weight per cell, one row of cells per possible finishing cell
+    quint64 finishWeight;           // Weight of a lone piece on the centre of its pagoda function
+    bool interrupted;
+    quint64 nodesSearched;
+
+    /**
+     * @brief Check whether the game can end with at most target pieces
+     * @param target Piece count to reach
+     * @param ply Distance from the root, selects the slice of moveBuffer
+     * @return True if such a line exists; it is then the incumbent. False if
+     *         refuted or if the search was stopped (see interrupted)
+     */
+    bool search(int target, int ply);
+
+    /**
+     * @brief Count the pieces of the current position
+     * @return Pegs in normal mode, holes in anti-peg mode
+     */
+    int pieceCount() const;
+
+    /**
+     * @brief Get the pieces of the current position
+     * @return One bit per occupied cell of the engine's layout, holes in anti-peg mode
+     */
+    quint64 pieceBits() const;
+
+    /**
+     * @brief Set up the pagoda functions of the cells a lone piece may finish on
+     *
+     * A finishing cell must match the root's rule-of-three class parities,
+     * which no jump changes. The weight of a cell at Manhattan distance d from
+     * the centre is Fib(D - d), with D two more than the largest distance, so a
+     * jump towards the centre keeps the total weight and every other jump
+     * lowers it.
+     */
+    void prepareFinishPagodas();
+
+    /**
+     * @brief Check the current position against the finishing cells' pagoda functions
+     * @return False if no single-piece finish is within reach
+     */
+    bool canFinishWithOnePiece() const;
+
+    /**
+     * @brief Offer the line to the current final position as the new best line
+     * @param finalCount Pieces left in the current final position
+     */
+    void offerIncumbent(int finalCount);
+};
+
+#endif // PEGCOUNTOPTIMIZER_H
@@ -0,0 +1,211 @@
+#include "models/SolutionCounter.h"
+#include "models/PegCountOptimizer.h"
+
+SolutionCount &SolutionCount::operator+=(const SolutionCount &other)
+{
+    quint64 sum = low + other.low;
+    high += other.high + (sum < low ? 1 : 0);
+    low = sum;
+    return *this;
+}
+
+bool SolutionCount::isZero() const
+{
+    return high == 0 && low == 0;
+}
+
+QString SolutionCount::toString() const
+{
+    if (high == 0) {
+        return QString::number(low);
+    }
+
+    // Long division by 10^9, collecting nine digits at a time
+    const quint64 chunkBase = 1000000000ULL;
+    quint32 words[4] = {quint32(high >> 32), quint32(high), quint32(low >> 32), quint32(low)};
+    QString digits;
+    bool nonZero = true;
+    while (nonZero) {
+        quint64 remainder = 0;
+        nonZero = false;
+        for (quint32 &word : words) {
+            quint64 value = (remainder << 32) | word;
+            word = quint32(value / chunkBase);
+            remainder = value % chunkBase;
+            nonZero = nonZero || word != 0;
+        }
+        QString chunk = QString::number(remainder);
+        digits.prepend(nonZero ? chunk.rightJustified(9, '0') : chunk);
+    }
+    return digits;
+}
+
+SolutionCounter::SolutionCounter(Board *board, TranspositionTable *table)
+    : board(board),
+      table(table),
+      stopToken(nullptr),
+      maxMovesPerPly(0),
+      interrupted(false),
+      nodesSearched(0),
+      currentPly(0),
+      rootMovesResolved(0),
+      rootMovesTotal(0),
+      progressIntervalNs(0),
+      nextProgressNs(0),
+      lastProgressNs(StopToken::nowNs()),
+      lastProgressNodes(0),
+      memoProbes(0),
+      memoHits(0),
+      lastProgressProbes(0),
+      lastProgressHits(0)
+{
+    if (!board) {
+        return;
+    }
+
+    // Every move changes the peg count by one, which bounds the line length
+    maxMovesPerPly = board->getMaxMoveCount();
+    moveBuffer.resize((board->getPlayableCellCount() + 1) * maxMovesPerPly);
+}
+
+bool SolutionCounter::count(const StopToken *stopToken)
+{
+    if (!board) {
+        return false;
+    }
+
+    this->stopToken = stopToken;
+    interrupted = false;
+    lastResult = SolutionCount();
+    rootMovesResolved = 0;
+    rootMovesTotal = 0;
+    if (memo.size() > MaxMemoEntries) {
+        memo.clear();
+    }
+
+    // The position classes never change along a line, so a position they rule
+    // out cannot have a single-piece finish anywhere below it
+    if (PegCountOptimizer::lowerBound(board) > 1) {
+        return true;
+    }
+
+    SolutionCount total = countFrom(0);
+    if (interrupted) {
+        return false;
+    }
+    lastResult = total;
+    return true;
+}
+
+void SolutionCounter::setProgressCallback(std::function<void(const SolverProgress &)> callback, int intervalMsecs)
+{
+    progressCallback = std::move(callback);
+    progressIntervalNs = qint64(intervalMsecs) * 1000000;
+    nextProgressNs = StopToken::nowNs() + progressIntervalNs;
+}
+
+SolutionCount SolutionCounter::result() const
+{
+    return lastResult;
+}
+
+int SolutionCounter::memoSize() const
+{
+    return memo.size();
+}
+
+quint64 SolutionCounter::getNodesSearched() const
+{
+    return nodesSearched;
+}
+
+SolutionCount SolutionCounter::countFrom(int ply)
+{
+    nodesSearched++;
+    if ((nodesSearched & (StopToken::CheckInterval - 1)) == 0) {
+        if (stopToken && stopToken->stopRequested()) {
+            interrupted = true;
+            return SolutionCount();
+        }
+        if (progressCallback && StopToken::nowNs() >= nextProgressNs) {
+            currentPly = ply;
+            progressCallback(progress());
+            nextProgressNs = lastProgressNs + progressIntervalNs;
+        }
+    }
+
+    if (board->isGameOver()) {
+        SolutionCount leaf;
+        leaf.low = board->isWinningState() ? 1 : 0;
+        return leaf;
+    }
+
+    quint64 stateId = board->getBoardStateId();
+    memoProbes++;
+    auto known = memo.constFind(stateId);
+    if (known != memo.constEnd()) {
+        memoHits++;
+        return *known;
+    }
+    if (table && table->isKnownFailure(stateId)) {
+        return SolutionCount();
+    }
+
+    Move *moves = moveBuffer.data() + ply * maxMovesPerPly;
+    int moveCount = board->generateMoves(moves);
+    if (ply == 0) {
+        rootMovesTotal = moveCount;
+    }
+
+    SolutionCount total;
+    for (int i = 0; i < moveCount; ++i) {
+        if (!board->performMove(moves[i])) {
+            continue;
+        }
+        total += countFrom(ply + 1);
+        board->undoLastMove();
+
+        if (interrupted) {
+            return SolutionCount();
+        }
+        if (ply == 0) {
+            rootMovesResolved++;
+        }
+    }
+
+    if (total.isZero()) {
+        if (table) {
+            table->markFailure(stateId);
+        }
+    } else {
+        memo.insert(stateId, total);
+        if (table) {
+            table->markWin(stateId);
+        }
+    }
+    return total;
+}
+
+SolverProgress SolutionCounter::progress()
+{
+    qint64 now = StopToken::nowNs();
+
+    SolverProgress snapshot;
+    snapshot.nodesSearched = nodesSearched;
+    snapshot.nodesPerSecond = now > lastProgressNs
+        ? (nodesSearched - lastProgressNodes) * 1e9 / (now - lastProgressNs)
+        : 0.0;
+    snapshot.tableSize = memo.size();
+    snapshot.tableHitRate = memoProbes > lastProgressProbes
+        ? double(memoHits - lastProgressHits) / (memoProbes - lastProgressProbes)
+        : 0.0;
+    snapshot.depth = currentPly;
+    snapshot.rootMovesResolved = rootMovesResolved;
+    snapshot.rootMovesTotal = rootMovesTotal;
+
+    lastProgressNs = now;
+    lastProgressNodes = nodesSearched;
+    lastProgressProbes = memoProbes;
+    lastProgressHits = memoHits;
+    return snapshot;
+}
@@ -0,0 +1,152 @@
+#ifndef SOLUTIONCOUNTER_H
+#define SOLUTIONCOUNTER_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <functional>
+#include "models/Board.h"
+#include "models/Solver.h"
+#include "models/StopToken.h"
+#include "models/TranspositionTable.h"
+
+/**
+ * @brief Unsigned 128-bit count of winning lines
+ *
+ * The number of winning lines from the opening of the larger boards does not
+ * fit in 64 bits, so counts are kept as two 64-bit halves.
+ */
+struct SolutionCount
+{
+    quint64 high = 0;
+    quint64 low = 0;
+
+    /**
+     * @brief Add another count, carrying into the high half
+     * @param other Count to add
+     * @return This count
+     */
+    SolutionCount &operator+=(const SolutionCount &other);
+
+    /**
+     * @brief Check if the count is zero
+     * @return True if no winning line was counted
+     */
+    bool isZero() const;
+
+    /**
+     * @brief Format the count in decimal
+     * @return Decimal digits of the count
+     */
+    QString toString() const;
+};
+
+/**
+ * @brief Counts the distinct winning move sequences from a position
+ *
+ * Two lines differing in any move are counted separately, even when they pass
+ * through the same positions. Since the number of winning continuations only
+ * depends on the position, and symmetric positions have equally many, every
+ * count is memoised per canonical state id and each shared subtree is counted
+ * only once.
+ *
+ * Positions without any winning line are not memoised; they are recorded in
+ * the shared transposition table instead, where they also prune the solver,
+ * and positions the solver has already proven lost are skipped outright.
+ * Positions found winnable are marked in the table as well.
+ *
+ * The memo is kept between counts on the same board, so counting again after
+ * a move is answered almost instantly.
+ */
+class SolutionCounter
+{
+public:
+    /**
+     * @brief Create a counter searching on the given board
+     * @param board Board to search on; moves are applied and undone in place
+     * @param table Shared table of positions proven won or lost, or null
+     */
+    SolutionCounter(Board *board, TranspositionTable *table = nullptr);
+
+    /**
+     * @brief Count the winning lines from the board's current position
+     * @param stopToken Polled every StopToken::CheckInterval nodes. May be null.
+     * @return True if the count is complete, false if the search was stopped
+     */
+    bool count(const StopToken *stopToken);
+
+    /**
+     * @brief Have the count report its progress while it runs
+     *
+     * Reports use the solver's format: the memo size stands in for the table
+     * size and the memo hit rate for the table hit rate. Checked together with
+     * the stop token, so reports arrive at most every intervalMsecs.
+     *
+     * @param callback Called from the counting thread, or null to disable
+     * @param intervalMsecs Minimum time between reports in milliseconds
+     */
+    void setProgressCallback(std::function<void(const SolverProgress &)> callback, int intervalMsecs);
+
+    /**
+     * @brief Get the result of the last complete count()
+     * @return Number of winning lines, zero before a complete count
+     */
+    SolutionCount result() const;
+
+    /**
+     * @brief Get the number of positions with a memoised count
+     * @return Memo size
+     */
+    int memoSize() const;
+
+    /**
+     * @brief Get the number of nodes expanded since the counter was created
+     * @return Node count
+     */
+    quint64 getNodesSearched() const;
+
+private:
+    // Memo entries kept between counts before the memo is dropped
+    static constexpr int MaxMemoEntries = 1 << 22;
+
+    Board *board;
+    TranspositionTable *table;
+    const StopToken *stopToken;
+
+    QHash<quint64, SolutionCount> memo; // Winning lines per canonical state id, non-zero only
+    QVector<Move> moveBuffer;           // Preallocated, maxMovesPerPly moves per ply
+    int maxMovesPerPly;
+    SolutionCount lastResult;
+    bool interrupted;
+    quint64 nodesSearched;
+    int currentPly;
+    int rootMovesResolved;
+    int rootMovesTotal;
+
+    // Progress reporting
+    std::function<void(const SolverProgress &)> progressCallback;
+    qint64 progressIntervalNs;
+    qint64 nextProgressNs;
+    qint64 lastProgressNs;
+    quint64 lastProgressNodes;
+    quint64 memoProbes;
+    quint64 memoHits;
+    quint64 lastProgressProbes;
+    quint64 lastProgressHits;
+
+    /**
+     * @brief Count the winning lines from the current position
+     * @param ply Distance from the root, selects the slice of moveBuffer
+     * @return Number of winning lines; meaningless if the search was stopped
+     */
+    SolutionCount countFrom(int ply);
+
+    /**
+     * @brief Take a progress snapshot of the count
+     * @return Current progress; throughput and hit rate cover the time since
+     *         the previous snapshot
+     */
+    SolverProgress progress();
+};
+
+#endif // SOLUTIONCOUNTER_H
@@ -0,0 +1,75 @@
+#include "models/Solver.h"
+#include <limits>
+
+Solver::Solver(Board *board, TranspositionTable &table)
+    : board(board),
+      solver(board ? &board->getCoreBoard() : nullptr, table)
+{
+}
+
+Solver::Result Solver::solve(const StopToken *stopToken)
+{
+    return solver.solve(stopToken);
+}
+
+bool Solver::reroot(quint64 stateBits)
+{
+    return solver.reroot(stateBits);
+}
+
+bool Solver::isSuspended() const
+{
+    return solver.isSuspended();
+}
+
+QVector<Move> Solver::solutionLine() const
+{
+    QVector<Move> line;
+    for (const pegcore::Move &move : solver.solutionLine()) {
+        line.append(board->fromCoreMove(move));
+    }
+    return line;
+}
+
+Move Solver::bestCandidateMove() const
+{
+    pegcore::Move move;
+    if (board && solver.bestCandidateMove(move)) {
+        return board->fromCoreMove(move);
+    }
+    return {Position{-1, -1}, Position{-1, -1}, Position{-1, -1}};
+}
+
+int Solver::scoreMove(Board *board, const Move &move)
+{
+    pegcore::Move coreMove;
+    if (!board->toCoreMove(move, coreMove)) {
+        return std::numeric_limits<int>::min();
+    }
+    return pegcore::Solver::scoreMove(board->getCoreBoard(), coreMove);
+}
+
+void Solver::setProgressCallback(std::function<void(const SolverProgress &)> callback, int intervalMsecs)
+{
+    solver.setProgressCallback(std::move(callback), intervalMsecs);
+}
+
+SolverProgress Solver::progress()
+{
+    return solver.progress();
+}
+
+int Solver::depth() const
+{
+    return solver.depth();
+}
+
+quint64 Solver::getNodesSearched() const
+{
+    return solver.getNodesSearched();
+}
+
+void Solver::reset()
+{
+    solver.reset();
+}
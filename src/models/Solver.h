@@ -0,0 +1,109 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <QVector>
+#include <functional>
+#include "core/Solver.h"
+#include "models/Board.h"
+#include "models/StopToken.h"
+#include "models/TranspositionTable.h"
+
+using SolverProgress = pegcore::SolverProgress;
+
+/**
+ * @brief Qt front end of the engine's pegcore::Solver
+ *
+ * Searches the engine position behind a Board and converts moves to and from
+ * grid positions; the search itself (iterative, resumable, re-rootable, see
+ * pegcore::Solver) runs entirely in the engine.
+ */
+class Solver
+{
+public:
+    using Result = pegcore::Solver::Result;
+
+    /**
+     * @brief Create a solver searching on the given board
+     * @param board Board to search on; moves are applied to it in place
+     * @param table Shared table of positions already proven won or lost
+     */
+    Solver(Board *board, TranspositionTable &table);
+
+    /**
+     * @brief Start a new search or resume a suspended one
+     * @param stopToken Polled every StopToken::CheckInterval nodes; when it fires
+     *                  the search is suspended. May be null.
+     * @return Outcome of the search
+     */
+    Result solve(const StopToken *stopToken);
+
+    /**
+     * @brief Move the root of the search onto a position on the current path
+     * @param stateBits Exact state bits (Board::getStateBits()) of the new root
+     * @return True if the position was found and the search state was kept,
+     *         false if the caller has to reset() and start over
+     */
+    bool reroot(quint64 stateBits);
+
+    /**
+     * @brief Check if a search was interrupted and can be resumed
+     * @return True if the frame stack holds a suspended search
+     */
+    bool isSuspended() const;
+
+    /**
+     * @brief Get the winning line found by the last successful solve()
+     * @return Moves from the root to the winning state, empty if not solved
+     */
+    QVector<Move> solutionLine() const;
+
+    /**
+     * @brief Get the most promising root move found so far
+     * @return Best candidate move, or invalid move if the search has not started
+     */
+    Move bestCandidateMove() const;
+
+    /**
+     * @brief Score a move for best-first ordering; higher is more promising
+     * @param board Board the move is played on; restored before returning
+     * @param move The move to score
+     * @return Heuristic score of the move
+     */
+    static int scoreMove(Board *board, const Move &move);
+
+    /**
+     * @brief Have the search report its progress while it runs
+     * @param callback Called from the searching thread, or null to disable
+     * @param intervalMsecs Minimum time between reports in milliseconds
+     */
+    void setProgressCallback(std::function<void(const SolverProgress &)> callback, int intervalMsecs);
+
+    /**
+     * @brief Take a progress snapshot of the search
+     * @return Current progress
+     */
+    SolverProgress progress();
+
+    /**
+     * @brief Get the number of frames currently on the stack
+     * @return Current search depth below the root
+     */
+    int depth() const;
+
+    /**
+     * @brief Get the number of nodes expanded since the solver was created
+     * @return Node count
+     */
+    quint64 getNodesSearched() const;
+
+    /**
+     * @brief Discard the search state and restore the board to the root position
+     */
+    void reset();
+
+private:
+    Board *board;
+    pegcore::Solver solver;
+};
+
+#endif // SOLVER_H
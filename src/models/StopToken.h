@@ -0,0 +1,9 @@
+#ifndef STOPTOKEN_H
+#define STOPTOKEN_H
+
+#include "core/StopToken.h"
+
+// The engine's cancellation flag, used as is by the Qt side
+using StopToken = pegcore::StopToken;
+
+#endif // STOPTOKEN_H
@@ -0,0 +1,9 @@
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include "core/TranspositionTable.h"
+
+// The engine's table of solved positions, used as is by the Qt side
+using TranspositionTable = pegcore::TranspositionTable;
+
+#endif // TRANSPOSITIONTABLE_H
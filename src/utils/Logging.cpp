@@ -0,0 +1,8 @@
+#include "Logging.h"
+
+Q_LOGGING_CATEGORY(lcApp, "peg.app", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcBoard, "peg.board", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcController, "peg.controller", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcEndgame, "peg.endgame", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcStrategy, "peg.strategy", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcView, "peg.view", QtInfoMsg)
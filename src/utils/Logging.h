@@ -0,0 +1,25 @@
+#ifndef LOGGING_H
+#define LOGGING_H
+
+#include <QLoggingCategory>
+
+/**
+ * @brief Logging categories of the game
+ *
+ * Log with qCDebug(lcController) etc. instead of qDebug(): the macro checks
+ * whether the category is enabled before any of the streamed arguments are
+ * evaluated, so a disabled log site costs one branch.
+ *
+ * Debug output is off by default and warnings are on. Enable categories with
+ * the QT_LOGGING_RULES environment variable, e.g.
+ * QT_LOGGING_RULES="peg.*.debug=true" for everything or
+ * QT_LOGGING_RULES="peg.strategy.debug=true" for the strategy worker only.
+ */
+Q_DECLARE_LOGGING_CATEGORY(lcApp)        // peg.app: main window and page navigation
+Q_DECLARE_LOGGING_CATEGORY(lcBoard)      // peg.board: board model and setup
+Q_DECLARE_LOGGING_CATEGORY(lcController) // peg.controller: moves, hints and game state
+Q_DECLARE_LOGGING_CATEGORY(lcEndgame)    // peg.endgame: endgame generation and pool
+Q_DECLARE_LOGGING_CATEGORY(lcStrategy)   // peg.strategy: background solver jobs
+Q_DECLARE_LOGGING_CATEGORY(lcView)       // peg.view: board and game views
+
+#endif // LOGGING_H
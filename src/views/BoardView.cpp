@@ -1,9 +1,10 @@
 #include "BoardView.h"
 #include "utils/ButtonStyles.h"
+#include "core/Trace.h"
 #include <QPainter>
 #include <QMouseEvent>
 #include <QKeyEvent>
-#include <QDebug>
+#include "utils/Logging.h"
 #include <QFont>
 #include <QSizePolicy>
 #include <QtCore/qmath.h>
@@ -12,6 +13,9 @@
 BoardView::BoardView(QWidget *parent)
     : QWidget(parent),
       boardModel(nullptr),
+      hasAnimatedMove(false),
+      animatedMove{{-1, -1}, {-1, -1}, {-1, -1}},
+      animationProgress(0.0),
       cellSize(40),
       pegRadius(15),
       boardMargin(20)
@@ -48,6 +52,8 @@ void BoardView::setupUI()
 void BoardView::setBoard(Board *board)
 {
     boardModel = board;
+    highlightedCells = QBitArray(boardModel ? boardModel->getRows() * boardModel->getCols() : 0);
+    invalidateRenderCache();
     if (boardModel) {
         calculateDynamicSizes();
         updateView();
@@ -60,10 +66,75 @@ void BoardView::updateView()
     update(); // Update the entire widget
 }
 
+void BoardView::updateCells(const QList<Position> &cells)
+{
+    if (!boardModel) {
+        return;
+    }
+
+    QRect centeredBoardRect = getCenteredBoardRect();
+    for (const Position &pos : cells) {
+        if (pos.row >= 0 && pos.col >= 0) {
+            update(getCellUpdateRect(pos, centeredBoardRect));
+        }
+    }
+}
+
+void BoardView::setAnimatedMove(const Move &move, qreal progress)
+{
+    if (!boardModel) {
+        return;
+    }
+
+    QRect centeredBoardRect = getCenteredBoardRect();
+    if (hasAnimatedMove) {
+        update(getMoveUpdateRect(animatedMove, centeredBoardRect));
+    }
+    hasAnimatedMove = true;
+    animatedMove = move;
+    animationProgress = qBound(0.0, progress, 1.0);
+    update(getMoveUpdateRect(animatedMove, centeredBoardRect));
+}
+
+void BoardView::clearAnimatedMove()
+{
+    if (!hasAnimatedMove) {
+        return;
+    }
+    hasAnimatedMove = false;
+    if (boardModel) {
+        update(getMoveUpdateRect(animatedMove, getCenteredBoardRect()));
+    }
+}
+
 void BoardView::highlightMoves(const QList<Move> &moves)
 {
-    highlightedMoves = moves;
-    updateView();
+    if (!boardModel) {
+        return;
+    }
+
+    // Flag the start and end cell of every move once, so painting tests a bit per cell
+    int rows = boardModel->getRows();
+    int cols = boardModel->getCols();
+    QBitArray cells(rows * cols);
+    for (const Move &move : moves) {
+        for (const Position &pos : {move.from, move.to}) {
+            if (pos.row >= 0 && pos.row < rows && pos.col >= 0 && pos.col < cols) {
+                cells.setBit(pos.row * cols + pos.col);
+            }
+        }
+    }
+
+    // Repaint only the cells whose highlight changed
+    QBitArray changed = cells ^ highlightedCells;
+    highlightedCells = cells;
+    QList<Position> changedCells;
+    for (int i = 0; i < changed.size(); ++i) {
+        if (changed.testBit(i)) {
+            changedCells.append(Position(i / cols, i % cols));
+        }
+    }
+    updateCells(changedCells);
 }
 
 void BoardView::updatePegCount(int count)
@@ -75,36 +146,56 @@ void BoardView::updatePegCount(int count)
 
 void BoardView::paintEvent(QPaintEvent *event)
 {
-    Q_UNUSED(event)
+    PEGCORE_TRACE_SCOPE("paint", "board");
     
     if (!boardModel) {
         return;
     }
 
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
-    
     // Get the centered board rectangle
     QRect centeredBoardRect = getCenteredBoardRect();
-    
-    // Fill the centered board background
-    painter.fillRect(centeredBoardRect, boardBackgroundColor);
+    QRect dirtyRect = event->rect() & centeredBoardRect;
+    if (dirtyRect.isEmpty()) {
+        return;
+    }
+
+    ensureRenderCache();
+
+    QPainter painter(this);
 
-    // Draw board cells
+    // Copy the exposed part of the static board: background, grid and holes
+    qreal dpr = boardLayer.devicePixelRatio();
+    QRectF sourceRect(QPointF(dirtyRect.topLeft() - centeredBoardRect.topLeft()) * dpr,
+                      QSizeF(dirtyRect.size()) * dpr);
+    painter.drawPixmap(QRectF(dirtyRect), boardLayer, sourceRect);
+
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    // Draw the pegs and highlights of the exposed cells, plus one cell around
+    // them since highlight rings can reach into neighbouring cells
     int rows = boardModel->getRows();
     int cols = boardModel->getCols();
+    QPoint origin = centeredBoardRect.topLeft() + QPoint(boardMargin, boardMargin);
+    int firstRow = qMax(0, (dirtyRect.top() - origin.y()) / cellSize - 1);
+    int lastRow = qMin(rows - 1, (dirtyRect.bottom() - origin.y()) / cellSize + 1);
+    int firstCol = qMax(0, (dirtyRect.left() - origin.x()) / cellSize - 1);
+    int lastCol = qMin(cols - 1, (dirtyRect.right() - origin.x()) / cellSize + 1);
     
-    for (int r = 0; r < rows; ++r) {
-        for (int c = 0; c < cols; ++c) {
+    for (int r = firstRow; r <= lastRow; ++r) {
+        for (int c = firstCol; c <= lastCol; ++c) {
             Position pos(r, c);
-            QPoint screenPos = getScreenPosition(pos);
-            
-            // Only draw if position is within the widget
-            if (rect().contains(screenPos)) {
-                drawCell(painter, pos, screenPos);
-            }
+            drawCell(painter, pos, getScreenPosition(pos, centeredBoardRect));
         }
     }
+
+    // The peg of a move in flight glides from its start cell to its target
+    if (hasAnimatedMove) {
+        QPointF from = getScreenPosition(animatedMove.from, centeredBoardRect);
+        QPointF to = getScreenPosition(animatedMove.to, centeredBoardRect);
+        QPointF center = from + (to - from) * animationProgress;
+        QSizeF spriteSize = pegSprite.deviceIndependentSize();
+        painter.drawPixmap(center - QPointF(spriteSize.width() / 2, spriteSize.height() / 2), pegSprite);
+    }
 }
 
 void BoardView::mousePressEvent(QMouseEvent *event)
@@ -121,7 +212,7 @@ void BoardView::mousePressEvent(QMouseEvent *event)
         
         PegState state = boardModel->getPegState(pos);
         if (state != PegState::Blocked) {
-            qDebug() << "BoardView: Clicked position (" << pos.row << "," << pos.col << ")";
+            qCDebug(lcView) << "BoardView: Clicked position (" << pos.row << "," << pos.col << ")";
             emit pegClicked(pos);
         }
     }
@@ -178,6 +269,36 @@ void BoardView::keyPressEvent(QKeyEvent *event)
         return;
     }
     
+    // Handle 'c' key for counting the winning lines
+    if (key == Qt::Key_C) {
+        emit countSolutionsRequested();
+        return;
+    }
+    
+    // Handle 'p' for solution playback, '+'/'-' for its speed and 'n' to step it
+    if (key == Qt::Key_P) {
+        emit solutionPlaybackRequested();
+        return;
+    }
+    if (key == Qt::Key_Plus || key == Qt::Key_Equal) {
+        emit playbackSpeedChangeRequested(1);
+        return;
+    }
+    if (key == Qt::Key_Minus) {
+        emit playbackSpeedChangeRequested(-1);
+        return;
+    }
+    if (key == Qt::Key_N) {
+        emit playbackStepRequested();
+        return;
+    }
+    
+    // Handle F3 for the solver statistics panel
+    if (key == Qt::Key_F3) {
+        emit statsPanelToggleRequested();
+        return;
+    }
+    
     // Pass other keys to parent
     QWidget::keyPressEvent(event);
 }
@@ -260,21 +381,35 @@ QPoint BoardView::getScreenPosition(const Position &pos)
         return QPoint(-1, -1);
     }
     
-    int x = centeredBoardRect.left() + boardMargin + pos.col * cellSize + cellSize / 2;
-    int y = centeredBoardRect.top() + boardMargin + pos.row * cellSize + cellSize / 2;
+    return getScreenPosition(pos, centeredBoardRect);
+}
+
+QPoint BoardView::getScreenPosition(const Position &pos, const QRect &boardRect) const
+{
+    int x = boardRect.left() + boardMargin + pos.col * cellSize + cellSize / 2;
+    int y = boardRect.top() + boardMargin + pos.row * cellSize + cellSize / 2;
     
     return QPoint(x, y);
 }
 
-bool BoardView::isPositionHighlighted(const Position &pos)
+QRect BoardView::getCellUpdateRect(const Position &pos, const QRect &boardRect) const
 {
-    for (const Move &move : highlightedMoves) {
-        if ((move.from.row == pos.row && move.from.col == pos.col) ||
-            (move.to.row == pos.row && move.to.col == pos.col)) {
-            return true;
-        }
-    }
-    return false;
+    // The highlight ring (radius pegRadius + 4, 3 px pen) can be wider than the cell
+    int halfExtent = qMax(cellSize / 2, pegRadius + 4 + 3);
+    QPoint center = getScreenPosition(pos, boardRect);
+    return QRect(center.x() - halfExtent, center.y() - halfExtent, 2 * halfExtent + 1, 2 * halfExtent + 1);
+}
+
+QRect BoardView::getMoveUpdateRect(const Move &move, const QRect &boardRect) const
+{
+    // Moves are straight, so the two end cells span the jumped one
+    return getCellUpdateRect(move.from, boardRect).united(getCellUpdateRect(move.to, boardRect));
+}
+
+bool BoardView::isPositionHighlighted(const Position &pos) const
+{
+    int index = pos.row * boardModel->getCols() + pos.col;
+    return index >= 0 && index < highlightedCells.size() && highlightedCells.testBit(index);
 }
 
 void BoardView::drawCell(QPainter &painter, const Position &pos, const QPoint &screenPos)
@@ -284,54 +419,38 @@ void BoardView::drawCell(QPainter &painter, const Position &pos, const QPoint &s
     }
 
     PegState state = boardModel->getPegState(pos);
-    
-    // Choose color based on state and highlights
-    QColor cellColor;
-    bool highlighted = isPositionHighlighted(pos);
-    
-    switch (state) {
-        case PegState::Peg:
-            cellColor = highlighted ? selectedColor : pegColor;
-            break;
-        case PegState::Empty:
-            cellColor = highlighted ? highlightColor : emptyColor;
-            break;
-        case PegState::Blocked:
-            cellColor = blockedColor;
-            break;
-    }
-
     if (state == PegState::Blocked) {
         // Don't draw anything for blocked cells
         return;
     }
 
-    // Draw the cell background (for grid appearance)
-    painter.setPen(QPen(Qt::black, 1));
-    painter.setBrush(QBrush(boardBackgroundColor));
-    QRect cellRect(screenPos.x() - cellSize/2, screenPos.y() - cellSize/2, cellSize, cellSize);
-    painter.drawRect(cellRect);
+    bool highlighted = isPositionHighlighted(pos);
 
+    // The grid and empty holes are already in the board layer; stamp the
+    // pegs and highlighted holes on top of it
+    const QPixmap *sprite = nullptr;
     if (state == PegState::Peg) {
-        // Draw peg as a filled circle
-        painter.setPen(QPen(Qt::black, 2));
-        painter.setBrush(QBrush(cellColor));
-        painter.drawEllipse(screenPos, pegRadius, pegRadius);
-        
-        // Add some shading for 3D effect
-        painter.setPen(QPen(Qt::white, 1));
-        painter.drawArc(screenPos.x() - pegRadius/2, screenPos.y() - pegRadius/2, 
-                       pegRadius, pegRadius, 45 * 16, 90 * 16);
-    } else if (state == PegState::Empty) {
-        // Draw empty hole as a circle outline
-        painter.setPen(QPen(Qt::black, 2));
-        painter.setBrush(QBrush(cellColor));
-        painter.drawEllipse(screenPos, pegRadius, pegRadius);
-        
-        // Draw inner shadow for hole effect
-        painter.setPen(QPen(Qt::darkGray, 1));
-        painter.setBrush(Qt::NoBrush);
-        painter.drawEllipse(screenPos, pegRadius - 2, pegRadius - 2);
+        sprite = highlighted ? &selectedPegSprite : &pegSprite;
+    } else if (highlighted) {
+        sprite = &highlightedHoleSprite;
+    }
+
+    // During a move in flight its peg is drawn in motion by paintEvent and the
+    // jumped peg fades out
+    qreal opacity = 1.0;
+    if (hasAnimatedMove && state == PegState::Peg) {
+        if (pos.row == animatedMove.from.row && pos.col == animatedMove.from.col) {
+            sprite = nullptr;
+        } else if (pos.row == animatedMove.jumped.row && pos.col == animatedMove.jumped.col) {
+            opacity = 1.0 - animationProgress;
+        }
+    }
+
+    if (sprite) {
+        QSizeF spriteSize = sprite->deviceIndependentSize();
+        painter.setOpacity(opacity);
+        painter.drawPixmap(QPointF(screenPos) - QPointF(spriteSize.width() / 2, spriteSize.height() / 2), *sprite);
+        painter.setOpacity(1.0);
     }
 
     // Draw highlight border if needed
@@ -342,6 +461,101 @@ void BoardView::drawCell(QPainter &painter, const Position &pos, const QPoint &s
     }
 }
 
+void BoardView::drawPeg(QPainter &painter, const QPoint &center, const QColor &color) const
+{
+    // Draw peg as a filled circle
+    painter.setPen(QPen(Qt::black, 2));
+    painter.setBrush(QBrush(color));
+    painter.drawEllipse(center, pegRadius, pegRadius);
+    
+    // Add some shading for 3D effect
+    painter.setPen(QPen(Qt::white, 1));
+    painter.drawArc(center.x() - pegRadius/2, center.y() - pegRadius/2, 
+                   pegRadius, pegRadius, 45 * 16, 90 * 16);
+}
+
+void BoardView::drawHole(QPainter &painter, const QPoint &center, const QColor &color) const
+{
+    // Draw empty hole as a circle outline
+    painter.setPen(QPen(Qt::black, 2));
+    painter.setBrush(QBrush(color));
+    painter.drawEllipse(center, pegRadius, pegRadius);
+    
+    // Draw inner shadow for hole effect
+    painter.setPen(QPen(Qt::darkGray, 1));
+    painter.setBrush(Qt::NoBrush);
+    painter.drawEllipse(center, pegRadius - 2, pegRadius - 2);
+}
+
+QPixmap BoardView::renderSprite(bool peg, const QColor &color) const
+{
+    // Room for the outline and its antialiasing on every side
+    int half = pegRadius + 3;
+    qreal dpr = devicePixelRatioF();
+
+    QPixmap sprite(QSize(2 * half, 2 * half) * dpr);
+    sprite.setDevicePixelRatio(dpr);
+    sprite.fill(Qt::transparent);
+
+    QPainter painter(&sprite);
+    painter.setRenderHint(QPainter::Antialiasing);
+    if (peg) {
+        drawPeg(painter, QPoint(half, half), color);
+    } else {
+        drawHole(painter, QPoint(half, half), color);
+    }
+    return sprite;
+}
+
+void BoardView::ensureRenderCache()
+{
+    qreal dpr = devicePixelRatioF();
+    if (!boardLayer.isNull() && boardLayer.devicePixelRatio() == dpr) {
+        return;
+    }
+    PEGCORE_TRACE_SCOPE("paint", "render cache");
+
+    QRect centeredBoardRect = getCenteredBoardRect();
+    boardLayer = QPixmap(centeredBoardRect.size() * dpr);
+    boardLayer.setDevicePixelRatio(dpr);
+    boardLayer.fill(boardBackgroundColor);
+
+    // Board coordinates relative to the layer's top-left corner
+    QPainter painter(&boardLayer);
+    painter.setRenderHint(QPainter::Antialiasing);
+    QRect layerRect(QPoint(0, 0), centeredBoardRect.size());
+    int rows = boardModel->getRows();
+    int cols = boardModel->getCols();
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            Position pos(r, c);
+            if (boardModel->getPegState(pos) == PegState::Blocked) {
+                continue;
+            }
+            QPoint center = getScreenPosition(pos, layerRect);
+
+            // Draw the cell background (for grid appearance)
+            painter.setPen(QPen(Qt::black, 1));
+            painter.setBrush(QBrush(boardBackgroundColor));
+            painter.drawRect(center.x() - cellSize/2, center.y() - cellSize/2, cellSize, cellSize);
+
+            drawHole(painter, center, emptyColor);
+        }
+    }
+
+    pegSprite = renderSprite(true, pegColor);
+    selectedPegSprite = renderSprite(true, selectedColor);
+    highlightedHoleSprite = renderSprite(false, highlightColor);
+}
+
+void BoardView::invalidateRenderCache()
+{
+    boardLayer = QPixmap();
+    pegSprite = QPixmap();
+    selectedPegSprite = QPixmap();
+    highlightedHoleSprite = QPixmap();
+}
+
 QSize BoardView::calculateBoardSize()
 {
     if (!boardModel) {
@@ -376,6 +590,10 @@ void BoardView::calculateDynamicSizes()
         return;
     }
 
+    int previousCellSize = cellSize;
+    int previousPegRadius = pegRadius;
+    int previousBoardMargin = boardMargin;
+
     // Start with default margin
     int tempMargin = 20;
     
@@ -399,6 +617,11 @@ void BoardView::calculateDynamicSizes()
     boardMargin = static_cast<int>(cellSize * 0.4);
     boardMargin = qMax(boardMargin, 8);   // Minimum margin
     boardMargin = qMin(boardMargin, 50);  // Maximum margin
+
+    // Most resize steps keep the cell size, and the cached board just moves
+    if (cellSize != previousCellSize || pegRadius != previousPegRadius || boardMargin != previousBoardMargin) {
+        invalidateRenderCache();
+    }
 }
 
 QRect BoardView::getCenteredBoardRect()
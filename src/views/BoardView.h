@@ -11,6 +11,8 @@
 #include <QMouseEvent>
 #include <QKeyEvent>
 #include <QShowEvent>
+#include <QPixmap>
+#include <QBitArray>
 #include <QList>
 #include "models/Board.h"
 
@@ -39,6 +41,28 @@ public:
      */
     void updateView();
 
+    /**
+     * @brief Repaint only the given cells, e.g. the three cells of a move
+     * @param cells Cells whose state changed
+     */
+    void updateCells(const QList<Position> &cells);
+
+    /**
+     * @brief Show a move in flight, with its peg part of the way to the target cell
+     *
+     * Used by solution playback; the board model is only changed once the move
+     * lands.
+     *
+     * @param move Move being played
+     * @param progress Fraction of the way from the start cell to the target cell, 0 to 1
+     */
+    void setAnimatedMove(const Move &move, qreal progress);
+
+    /**
+     * @brief Stop showing a move in flight
+     */
+    void clearAnimatedMove();
+
     /**
      * @brief Highlight valid moves on the board
      * @param moves List of moves to highlight
@@ -76,6 +100,32 @@ signals:
      */
     void suggestMoveClicked();
 
+    /**
+     * @brief Emitted when the C key is pressed to count the winning lines
+     */
+    void countSolutionsRequested();
+
+    /**
+     * @brief Emitted when F3 is pressed to show or hide the solver statistics
+     */
+    void statsPanelToggleRequested();
+
+    /**
+     * @brief Emitted when P is pressed to play or stop playing the solution
+     */
+    void solutionPlaybackRequested();
+
+    /**
+     * @brief Emitted when + or - is pressed to change the playback speed
+     * @param steps 1 for faster, -1 for slower
+     */
+    void playbackSpeedChangeRequested(int steps);
+
+    /**
+     * @brief Emitted when N is pressed to play the next move of the solution
+     */
+    void playbackStepRequested();
+
     /**
      * @brief Emitted when WASD keys are pressed for peg selection
      * @param direction Direction to search for peg (0=up/W, 1=left/A, 2=down/S, 3=right/D)
@@ -134,7 +184,12 @@ private slots:
 private:
     // Board data
     Board *boardModel;
-    QList<Move> highlightedMoves;
+    QBitArray highlightedCells; // One flag per grid cell, indexed by row * columns + column
+
+    // Move in flight during solution playback
+    bool hasAnimatedMove;
+    Move animatedMove;
+    qreal animationProgress;
     
     // Visual properties - now dynamic
     int cellSize;
@@ -148,6 +203,12 @@ private:
     QColor selectedColor;
     QColor highlightColor;
     QColor boardBackgroundColor;
+
+    // Pre-rendered layers, rebuilt when the cell size, board or device pixel ratio changes
+    QPixmap boardLayer;           // Background, grid and empty holes of the whole board
+    QPixmap pegSprite;
+    QPixmap selectedPegSprite;
+    QPixmap highlightedHoleSprite;
     
     /**
      * @brief Initialize the UI components
@@ -172,13 +233,37 @@ private:
      * @return Screen coordinates for the center of the cell
      */
     QPoint getScreenPosition(const Position &pos);
+
+    /**
+     * @brief Convert board position to screen coordinates within a known board rectangle
+     * @param pos Board position
+     * @param boardRect Centered board rectangle from getCenteredBoardRect()
+     * @return Screen coordinates for the center of the cell
+     */
+    QPoint getScreenPosition(const Position &pos, const QRect &boardRect) const;
     
+    /**
+     * @brief Get the area a cell's drawing can cover, including its highlight ring
+     * @param pos Board position
+     * @param boardRect Centered board rectangle from getCenteredBoardRect()
+     * @return Widget rectangle to repaint when the cell changes
+     */
+    QRect getCellUpdateRect(const Position &pos, const QRect &boardRect) const;
+
+    /**
+     * @brief Get the area a move in flight can cover, from its start to its target cell
+     * @param move The move
+     * @param boardRect Centered board rectangle from getCenteredBoardRect()
+     * @return Widget rectangle to repaint while the move is animated
+     */
+    QRect getMoveUpdateRect(const Move &move, const QRect &boardRect) const;
+
     /**
      * @brief Check if a position is highlighted for moves
      * @param pos Position to check
      * @return True if position is highlighted
      */
-    bool isPositionHighlighted(const Position &pos);
+    bool isPositionHighlighted(const Position &pos) const;
     
     /**
      * @brief Draw a single cell (peg, empty, or blocked)
@@ -186,7 +271,41 @@ private:
      * @param pos Board position
      * @param screenPos Screen coordinates
      */
-    void drawCell(QPainter &painter, const Position &pos, const QPoint &screenPos);    /**
+    void drawCell(QPainter &painter, const Position &pos, const QPoint &screenPos);
+
+    /**
+     * @brief Draw a peg
+     * @param painter Painter object
+     * @param center Center of the peg
+     * @param color Fill color
+     */
+    void drawPeg(QPainter &painter, const QPoint &center, const QColor &color) const;
+
+    /**
+     * @brief Draw an empty hole
+     * @param painter Painter object
+     * @param center Center of the hole
+     * @param color Fill color
+     */
+    void drawHole(QPainter &painter, const QPoint &center, const QColor &color) const;
+
+    /**
+     * @brief Render a peg or hole into a transparent sprite
+     * @param peg True for a peg, false for a hole
+     * @param color Fill color
+     * @return Sprite at the current device pixel ratio, centered on its middle pixel
+     */
+    QPixmap renderSprite(bool peg, const QColor &color) const;
+
+    /**
+     * @brief Rebuild the board layer and sprites if they are missing or stale
+     */
+    void ensureRenderCache();
+
+    /**
+     * @brief Drop the board layer and sprites so the next paint rebuilds them
+     */
+    void invalidateRenderCache();    /**
      * @brief Calculate the board widget size based on board dimensions
      * @return Recommended size for the board widget
      */
@@ -1,6 +1,7 @@
 #include "GameView.h"
 #include "utils/ButtonStyles.h"
-#include <QDebug>
+#include "core/Stats.h"
+#include "utils/Logging.h"
 #include <QFont>
 #include <QDialog>
 #include <QMessageBox>
@@ -19,6 +20,9 @@ GameView::GameView(QWidget *parent)
       pegCountLabel(nullptr),
       informationBoardTitle(nullptr),
       informationDisplay(nullptr),
+      informationRefreshPending(false),
+      statsPanel(nullptr),
+      statsRefreshTimer(nullptr),
       undoButton(nullptr),
       resetButton(nullptr),
       homeButton(nullptr),      guideButton(nullptr),
@@ -45,7 +49,7 @@ GameView::GameView(QWidget *parent)
             this, &GameView::navigateToHome);
     connect(boardController, &BoardController::gameOver,
             this, &GameView::onGameOver);
-    connect(boardController, &BoardController::informationUpdated,
+    connect(boardController, &BoardController::informationChanged,
             this, &GameView::updateInformation);
     
     // Connect view signals to controller
@@ -57,6 +61,16 @@ GameView::GameView(QWidget *parent)
             boardController, &BoardController::onHomeClicked);
     connect(boardView, &BoardView::suggestMoveClicked,
             boardController, &BoardController::onSuggestMoveClicked);
+    connect(boardView, &BoardView::countSolutionsRequested,
+            boardController, &BoardController::onCountSolutionsClicked);
+    connect(boardView, &BoardView::solutionPlaybackRequested,
+            boardController, &BoardController::onPlaySolutionRequested);
+    connect(boardView, &BoardView::playbackSpeedChangeRequested,
+            boardController, &BoardController::onPlaybackSpeedChangeRequested);
+    connect(boardView, &BoardView::playbackStepRequested,
+            boardController, &BoardController::onPlaybackStepRequested);
+    connect(boardView, &BoardView::statsPanelToggleRequested,
+            this, &GameView::toggleStatsPanel);
     
     // Connect keyboard navigation signals
     connect(boardView, &BoardView::pegSelectionRequested,
@@ -193,6 +207,31 @@ void GameView::setupUI()
     rightSideLayout->addWidget(pegCountLabel);
     rightSideLayout->addWidget(informationBoardTitle);
     rightSideLayout->addWidget(informationDisplay);
+    
+    // Solver statistics, refreshed twice a second while shown
+    statsPanel = new QLabel(this);
+    QFont statsFont("Monospace");
+    statsFont.setStyleHint(QFont::Monospace);
+    statsFont.setPointSize(9);
+    statsPanel->setFont(statsFont);
+    statsPanel->setAlignment(Qt::AlignTop | Qt::AlignLeft);
+    statsPanel->setWordWrap(true);
+    statsPanel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    statsPanel->setStyleSheet(
+        "QLabel {"
+        "color: #2c3e50;"
+        "background: #ffffff;"
+        "border: 2px solid #95a5a6;"
+        "border-radius: 8px;"
+        "padding: 8px;"
+        "}"
+    );
+    statsPanel->hide();
+    statsRefreshTimer = new QTimer(this);
+    statsRefreshTimer->setInterval(500);
+    connect(statsRefreshTimer, &QTimer::timeout, this, &GameView::refreshStatsPanel);
+    
+    rightSideLayout->addWidget(statsPanel);
     rightSideLayout->addStretch(); // Push content to top
     
     gameLayout->addLayout(rightSideLayout, 1); // Give scoring board less space (25%)
@@ -209,17 +248,54 @@ void GameView::updatePegCount(int count)
     }
 }
 
-void GameView::updateInformation(const QString &message)
+void GameView::updateInformation()
 {
-    if (informationDisplay) {
-        informationDisplay->setText(message);
+    if (!informationRefreshPending) {
+        informationRefreshPending = true;
+        QMetaObject::invokeMethod(this, &GameView::refreshInformation, Qt::QueuedConnection);
     }
 }
 
+void GameView::refreshInformation()
+{
+    informationRefreshPending = false;
+
+    // A hidden display is brought up to date by showEvent
+    if (informationDisplay && informationDisplay->isVisible() && boardController) {
+        informationDisplay->setText(boardController->information());
+    }
+}
+
+void GameView::toggleStatsPanel()
+{
+    if (statsPanel->isVisible()) {
+        statsRefreshTimer->stop();
+        statsPanel->hide();
+        return;
+    }
+    refreshStatsPanel();
+    statsPanel->show();
+    statsRefreshTimer->start();
+}
+
+void GameView::refreshStatsPanel()
+{
+    pegcore::SolverStats stats = pegcore::Stats::snapshot();
+
+    // The full per-ply table is too tall for the side panel; one average per ply instead
+    QString text = QString::fromStdString(stats.toText(false));
+    QStringList plies;
+    for (int ply = 0; ply <= stats.maxDepth && ply < pegcore::SolverStats::MaxPly; ++ply) {
+        plies.append(QString::number(stats.averageBranching(ply), 'f', 1));
+    }
+    text += "Branching by ply:\n" + plies.join(' ');
+    statsPanel->setText(text);
+}
+
 void GameView::setBoard(Board *board)
 {
     if (boardController && boardView) {
-        qDebug() << "GameView: Setting board model";
+        qCDebug(lcView) << "GameView: Setting board model";
         
         // Set the board in both controller and view
         boardController->setBoardModel(board);
@@ -233,7 +309,21 @@ void GameView::setBoard(Board *board)
         // Give focus to the board view so keyboard controls work
         boardView->setFocus();
         
-        qDebug() << "GameView: Board model set successfully";
+        qCDebug(lcView) << "GameView: Board model set successfully";
+    }
+}
+
+void GameView::setPonderingEnabled(bool enabled)
+{
+    if (boardController) {
+        boardController->setPonderingEnabled(enabled);
+    }
+}
+
+void GameView::setEndgamePool(EndgamePool *pool)
+{
+    if (boardController) {
+        boardController->setEndgamePool(pool);
     }
 }
 
@@ -355,6 +445,10 @@ void GameView::showGuideDialog()
         "<p>• <b>W/A/S/D:</b> Select peg in the corresponding direction</p>"
         "<p>• <b>Arrow Keys:</b> Move selected peg in the corresponding direction</p>"
         "<p>• <b>Spacebar:</b> Get a suggested move</p>"
+        "<p>• <b>C:</b> Count the winning move sequences from the current position</p>"
+        "<p>• <b>P:</b> Play the solution from the current position, or stop playing it</p>"
+        "<p>• <b>+/-:</b> Change the playback speed; <b>N:</b> Play the next move</p>"
+        "<p>• <b>F3:</b> Show or hide the solver statistics</p>"
         "<p>• <b>B:</b> Undo last move</p>"
         "<p>• <b>R:</b> Reset the board</p>"
         "<p><b>Tip:</b> Try to work towards the center of the board!</p>"
@@ -426,6 +520,12 @@ void GameView::keyPressEvent(QKeyEvent *event)
     QWidget::keyPressEvent(event);
 }
 
+void GameView::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    refreshInformation();
+}
+
 void GameView::onGameOver()
 {
     if (!boardController || !boardController->getBoardModel()) {
@@ -436,7 +536,7 @@ void GameView::onGameOver()
     int pegCount = board->getPegCount();
     bool isWin = board->isWinningState();
     
-    qDebug() << "GameView: Game over detected. Peg count:" << pegCount << "Win:" << isWin << "Anti-peg mode:" << board->isAntiPegMode();
+    qCDebug(lcView) << "GameView: Game over detected. Peg count:" << pegCount << "Win:" << isWin << "Anti-peg mode:" << board->isAntiPegMode();
     
     showGameResultOverlay(isWin, pegCount);
 }
@@ -8,6 +8,7 @@
 #include <QPushButton>
 #include <QDialog>
 #include <QKeyEvent>
+#include <QTimer>
 #include "views/BoardView.h"
 #include "controllers/BoardController.h"
 #include "models/Board.h"
@@ -35,6 +36,18 @@ public:
      */
     void setBoard(Board *board);
 
+    /**
+     * @brief Enable or disable background pondering of hints
+     * @param enabled True to solve positions in the background after every move
+     */
+    void setPonderingEnabled(bool enabled);
+
+    /**
+     * @brief Set the pool endgame positions are taken from on reset
+     * @param pool Pool of generated endgames, or null
+     */
+    void setEndgamePool(EndgamePool *pool);
+
 signals:
     /**
      * @brief Emitted when user requests to navigate back to home
@@ -52,6 +65,11 @@ protected:
      */
     void keyPressEvent(QKeyEvent *event) override;
 
+    /**
+     * @brief Show the information message that changed while the view was hidden
+     */
+    void showEvent(QShowEvent *event) override;
+
 private:
     // Main layout structure
     QVBoxLayout *mainLayout;
@@ -67,6 +85,11 @@ private:
     // Information board components
     QLabel *informationBoardTitle;
     QLabel *informationDisplay;
+    bool informationRefreshPending; // A refresh of the information display is queued
+    
+    // Solver statistics debug panel, hidden until toggled with F3
+    QLabel *statsPanel;
+    QTimer *statsRefreshTimer;
       // Control buttons (upper right)
     QPushButton *undoButton;
     QPushButton *resetButton;
@@ -91,10 +114,17 @@ private:
     void updatePegCount(int count);
     
     /**
-     * @brief Update the information display
-     * @param message Information message to display
+     * @brief Queue a refresh of the information display
+     *
+     * Several messages set during one event are coalesced, so only the
+     * last one is formatted.
      */
-    void updateInformation(const QString &message);
+    void updateInformation();
+
+    /**
+     * @brief Show the controller's current information message if the display is visible
+     */
+    void refreshInformation();
       /**
      * @brief Show the guide information dialog
      */
@@ -112,6 +142,16 @@ private slots:
      * @brief Handle game over signal from board controller
      */
     void onGameOver();
+
+    /**
+     * @brief Show or hide the solver statistics panel
+     */
+    void toggleStatsPanel();
+
+    /**
+     * @brief Fill the statistics panel from a fresh snapshot of the search counters
+     */
+    void refreshStatsPanel();
 };
 
 #endif // GAMEVIEW_H
@@ -1,13 +1,23 @@
 #include "LoadingCircle.h"
+#include "core/Trace.h"
 #include <QPainter>
+#include <QPaintEvent>
 #include <QResizeEvent>
 #include <QFont>
 #include <QFontMetrics>
 #include <QtCore/qmath.h>
 
+// Time for one turn of the circle
+static const int SpinPeriodMsecs = 1800;
+
+// Angle the circle turns before it is repainted; keeps repaints to about 33
+// per second however fast the animation driver ticks, leaving the CPU to the
+// solver threads
+static const int SpinStepDegrees = 6;
+
 LoadingCircle::LoadingCircle(QWidget *parent)
     : QWidget(parent),
-      animationTimer(new QTimer(this)),
+      spinAnimation(new QVariantAnimation(this)),
       rotationAngle(0),
       message("Searching for solution...")
 {
@@ -16,9 +26,13 @@ LoadingCircle::LoadingCircle(QWidget *parent)
     setAttribute(Qt::WA_TranslucentBackground);
     hide();
     
-    // Set up the animation timer
-    connect(animationTimer, &QTimer::timeout, this, &LoadingCircle::updateAnimation);
-    animationTimer->setInterval(50); // 20 FPS animation
+    // One turn of the circle per SpinPeriodMsecs, stepped by Qt's animation
+    // driver in time with the display instead of by a free-running timer
+    spinAnimation->setStartValue(0);
+    spinAnimation->setEndValue(360);
+    spinAnimation->setDuration(SpinPeriodMsecs);
+    spinAnimation->setLoopCount(-1);
+    connect(spinAnimation, &QVariantAnimation::valueChanged, this, &LoadingCircle::updateAnimation);
     
     calculateCircleRect();
 }
@@ -30,50 +44,113 @@ LoadingCircle::~LoadingCircle()
 
 void LoadingCircle::startAnimation()
 {
+    if (!details.isEmpty()) {
+        details.clear();
+        backdropLayer = QPixmap();
+    }
     show();
     raise();
-    animationTimer->start();
+    if (spinAnimation->state() != QAbstractAnimation::Running) {
+        spinAnimation->start();
+    }
 }
 
 void LoadingCircle::stopAnimation()
 {
-    animationTimer->stop();
+    spinAnimation->stop();
     hide();
 }
 
 void LoadingCircle::setMessage(const QString &newMessage)
 {
+    if (newMessage == message) {
+        return;
+    }
     message = newMessage;
-    update();
+    backdropLayer = QPixmap();
+    update(textUpdateRect());
+}
+
+void LoadingCircle::setDetails(const QString &newDetails)
+{
+    if (newDetails == details) {
+        return;
+    }
+    details = newDetails;
+    backdropLayer = QPixmap();
+    update(textUpdateRect());
 }
 
-void LoadingCircle::updateAnimation()
+void LoadingCircle::updateAnimation(const QVariant &value)
 {
-    rotationAngle = (rotationAngle + 10) % 360;
-    update();
+    int angle = value.toInt() / SpinStepDegrees * SpinStepDegrees % 360;
+    if (angle == rotationAngle) {
+        return;
+    }
+    rotationAngle = angle;
+    update(spinnerUpdateRect());
 }
 
 void LoadingCircle::paintEvent(QPaintEvent *event)
 {
-    Q_UNUSED(event)
+    PEGCORE_TRACE_SCOPE("paint", "loading circle");
+    ensureBackdropLayer();
     
     QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
     
-    // Fill background with semi-transparent overlay
-    painter.fillRect(rect(), QColor(0, 0, 0, 100));
+    // Copy the exposed part of the overlay, message and details
+    QRect dirtyRect = event->rect();
+    qreal dpr = backdropLayer.devicePixelRatio();
+    painter.drawPixmap(QRectF(dirtyRect), backdropLayer,
+                       QRectF(QPointF(dirtyRect.topLeft()) * dpr, QSizeF(dirtyRect.size()) * dpr));
     
     // Draw the loading circle
-    drawLoadingCircle(painter);
-    
-    // Draw the message
-    drawMessage(painter);
+    if (dirtyRect.intersects(spinnerUpdateRect())) {
+        painter.setRenderHint(QPainter::Antialiasing);
+        drawLoadingCircle(painter);
+    }
 }
 
 void LoadingCircle::resizeEvent(QResizeEvent *event)
 {
     QWidget::resizeEvent(event);
     calculateCircleRect();
+    backdropLayer = QPixmap();
+}
+
+QRect LoadingCircle::spinnerUpdateRect() const
+{
+    // The arcs stay inside the circle rectangle; the margin covers antialiasing
+    return circleRect.adjusted(-2, -2, 2, 2);
+}
+
+QRect LoadingCircle::textUpdateRect() const
+{
+    return QRect(0, circleRect.bottom() + 1, width(), height() - circleRect.bottom() - 1);
+}
+
+void LoadingCircle::ensureBackdropLayer()
+{
+    qreal dpr = devicePixelRatioF();
+    if (!backdropLayer.isNull() && backdropLayer.devicePixelRatio() == dpr) {
+        return;
+    }
+    PEGCORE_TRACE_SCOPE("paint", "loading backdrop");
+
+    backdropLayer = QPixmap(size() * dpr);
+    backdropLayer.setDevicePixelRatio(dpr);
+    backdropLayer.fill(Qt::transparent);
+
+    QPainter painter(&backdropLayer);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setFont(font());
+    
+    // Fill background with semi-transparent overlay
+    painter.fillRect(rect(), QColor(0, 0, 0, 100));
+    
+    // Draw the message
+    drawMessage(painter);
+    drawDetails(painter);
 }
 
 void LoadingCircle::calculateCircleRect()
@@ -153,3 +230,25 @@ void LoadingCircle::drawMessage(QPainter &painter)
     
     painter.restore();
 }
+
+void LoadingCircle::drawDetails(QPainter &painter)
+{
+    if (details.isEmpty()) {
+        return;
+    }
+
+    painter.save();
+
+    QFont font = painter.font();
+    font.setPointSize(10);
+    painter.setFont(font);
+
+    // Centered block below the message line
+    QRect textRect(0, circleRect.bottom() + 42, width(), height() - circleRect.bottom() - 42);
+    painter.setPen(QColor(0, 0, 0, 150));
+    painter.drawText(textRect.translated(1, 1), Qt::AlignHCenter | Qt::AlignTop, details);
+    painter.setPen(QColor(220, 220, 220));
+    painter.drawText(textRect, Qt::AlignHCenter | Qt::AlignTop, details);
+
+    painter.restore();
+}
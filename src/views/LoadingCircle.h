@@ -2,8 +2,9 @@
 #define LOADINGCIRCLE_H
 
 #include <QWidget>
-#include <QTimer>
+#include <QVariantAnimation>
 #include <QPainter>
+#include <QPixmap>
 #include <QRect>
 
 /**
@@ -11,6 +12,8 @@
  * 
  * This widget displays a spinning circle animation to indicate loading or processing.
  * It can be overlaid on top of other widgets and shows animated progress.
+ * The backdrop and text are rendered once into a cached layer, and each
+ * animation step repaints only the circle.
  */
 class LoadingCircle : public QWidget
 {
@@ -36,23 +39,48 @@ public:
      */
     void setMessage(const QString &message);
 
+    /**
+     * @brief Set the smaller detail text displayed below the message
+     * @param details The detail text, may span several lines; empty to hide
+     */
+    void setDetails(const QString &details);
+
 protected:
     void paintEvent(QPaintEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
 
 private slots:
-    void updateAnimation();
+    void updateAnimation(const QVariant &value);
 
 private:
-    QTimer *animationTimer;
+    QVariantAnimation *spinAnimation;
     int rotationAngle;
     QString message;
+    QString details;
     QRect circleRect;
+    QPixmap backdropLayer; // Overlay fill, message and details; null when stale
     
     /**
      * @brief Calculate the position and size of the loading circle
      */
     void calculateCircleRect();
+
+    /**
+     * @brief Get the area repainted by an animation step
+     * @return Circle rectangle grown by the arc pen
+     */
+    QRect spinnerUpdateRect() const;
+
+    /**
+     * @brief Get the area holding the message and details
+     * @return Full-width rectangle below the circle
+     */
+    QRect textUpdateRect() const;
+
+    /**
+     * @brief Render the backdrop layer if it is stale
+     */
+    void ensureBackdropLayer();
     
     /**
      * @brief Draw the loading circle
@@ -65,6 +93,12 @@ private:
      * @param painter The painter to draw with
      */
     void drawMessage(QPainter &painter);
+
+    /**
+     * @brief Draw the detail text below the message
+     * @param painter The painter to draw with
+     */
+    void drawDetails(QPainter &painter);
 };
 
 #endif // LOADINGCIRCLE_H
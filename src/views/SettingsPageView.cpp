@@ -16,6 +16,20 @@ SettingsPageView::SettingsPageView(QWidget *parent)
     // Fullscreen CheckBox
     fullscreenCheckBox = new QCheckBox("Enable Fullscreen", this);
 
+    // Ponder CheckBox - think about hints in the background while the player moves
+    ponderCheckBox = new QCheckBox("Think Ahead in Background", this);
+    ponderCheckBox->setToolTip("Solve the current position at low priority after every move so hints appear instantly");
+
+    // Endgame difficulty - how many winning lines the generated endgames leave
+    difficultyLabel = new QLabel("Endgame Difficulty:", this);
+    difficultyComboBox = new QComboBox(this);
+    difficultyComboBox->addItems({"Easy", "Medium", "Hard"});
+    difficultyComboBox->setCurrentIndex(static_cast<int>(EndgameDifficulty::Medium));
+    difficultyComboBox->setToolTip("Harder endgames start with more pegs and fewer ways to win");
+    QHBoxLayout *difficultyLayout = new QHBoxLayout();
+    difficultyLayout->addWidget(difficultyLabel);
+    difficultyLayout->addWidget(difficultyComboBox);
+
     // Back Button
     backButton = new QPushButton("Back to Home", this);
     
@@ -26,6 +40,8 @@ SettingsPageView::SettingsPageView(QWidget *parent)
     mainLayout = new QVBoxLayout(this);
     mainLayout->addWidget(titleLabel);
     mainLayout->addWidget(fullscreenCheckBox);
+    mainLayout->addWidget(ponderCheckBox);
+    mainLayout->addLayout(difficultyLayout);
     mainLayout->addStretch(); // Add stretch to push the button to the bottom or provide spacing
     mainLayout->addWidget(backButton);
     mainLayout->setAlignment(Qt::AlignCenter);
@@ -36,6 +52,8 @@ SettingsPageView::SettingsPageView(QWidget *parent)
     // Connect signals
     connect(backButton, &QPushButton::clicked, this, &SettingsPageView::backClicked);
     connect(fullscreenCheckBox, &QCheckBox::checkStateChanged, this, &SettingsPageView::onFullscreenCheckBoxStateChanged);
+    connect(ponderCheckBox, &QCheckBox::checkStateChanged, this, &SettingsPageView::onPonderCheckBoxStateChanged);
+    connect(difficultyComboBox, &QComboBox::currentIndexChanged, this, &SettingsPageView::onDifficultyComboBoxIndexChanged);
 }
 
 SettingsPageView::~SettingsPageView()
@@ -56,3 +74,28 @@ void SettingsPageView::onFullscreenCheckBoxStateChanged(int state)
 {
     emit fullscreenToggled(state == Qt::Checked);
 }
+
+bool SettingsPageView::isPonderChecked() const
+{
+    return ponderCheckBox->isChecked();
+}
+
+void SettingsPageView::onPonderCheckBoxStateChanged(int state)
+{
+    emit ponderToggled(state == Qt::Checked);
+}
+
+EndgameDifficulty SettingsPageView::getEndgameDifficulty() const
+{
+    return static_cast<EndgameDifficulty>(difficultyComboBox->currentIndex());
+}
+
+void SettingsPageView::setEndgameDifficulty(EndgameDifficulty difficulty)
+{
+    difficultyComboBox->setCurrentIndex(static_cast<int>(difficulty));
+}
+
+void SettingsPageView::onDifficultyComboBoxIndexChanged(int index)
+{
+    emit endgameDifficultyChanged(static_cast<EndgameDifficulty>(index));
+}
@@ -3,9 +3,12 @@
 
 #include <QWidget>
 #include <QCheckBox>
+#include <QComboBox>
 #include <QPushButton>
 #include <QVBoxLayout>
+#include <QHBoxLayout>
 #include <QLabel>
+#include "models/EndgameGenerator.h"
 
 class SettingsPageView : public QWidget
 {
@@ -17,17 +20,27 @@ public:
 
     bool isFullscreenChecked() const;
     void setFullscreenChecked(bool checked);
+    bool isPonderChecked() const;
+    EndgameDifficulty getEndgameDifficulty() const;
+    void setEndgameDifficulty(EndgameDifficulty difficulty);
 
 signals:
     void backClicked();
     void fullscreenToggled(bool checked);
+    void ponderToggled(bool checked);
+    void endgameDifficultyChanged(EndgameDifficulty difficulty);
 
 private slots:
     void onFullscreenCheckBoxStateChanged(int state);
+    void onPonderCheckBoxStateChanged(int state);
+    void onDifficultyComboBoxIndexChanged(int index);
 
 private:
     QLabel *titleLabel;
     QCheckBox *fullscreenCheckBox;
+    QCheckBox *ponderCheckBox;
+    QLabel *difficultyLabel;
+    QComboBox *difficultyComboBox; // Items in EndgameDifficulty order
     QPushButton *backButton;
     QVBoxLayout *mainLayout;
 };